@@ -0,0 +1,217 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // max
+#include <atomic>
+#include <cstddef> // size_t
+#include <memory> // unique_ptr
+#include <mutex>
+#include <stdexcept> // runtime_error
+#include <type_traits>
+#include <utility> // exchange, forward, move
+#include <vector>
+
+#include "some.hpp"
+
+namespace vx {
+
+struct hazard_slots_exhausted : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+/// ===== [ Hazard pointers ] =====
+/// A thread announces the node it's about to read in one of the slots of its hazard_record,
+/// a writer only deletes the retired nodes that aren't announced anywhere.
+/// The records are shared by all the atomic_fsomes, one per thread, taken over by the new threads once the old ones exit.
+struct hazard_record {
+    static constexpr std::size_t n_slots = 4; ///< the loads a thread can hold at the same time
+
+    std::atomic<const void*> slots[n_slots] {};
+    std::atomic<bool> active {true};
+    hazard_record * next = nullptr;
+};
+
+inline std::atomic<hazard_record *> hazard_records {nullptr};
+
+/// the record of this thread, taken on its first load and released when the thread exits
+inline hazard_record & this_thread_hazards() {
+    struct owner {
+        hazard_record * record;
+
+        owner() : record{acquire()} {}
+        ~owner() { record->active.store(false, std::memory_order_release); }
+
+        static hazard_record * acquire() {
+            for (auto * r = hazard_records.load(std::memory_order_acquire); r; r = r->next) {
+                bool active = false;
+                if (not r->active.load(std::memory_order_relaxed)
+                    && r->active.compare_exchange_strong(active, true, std::memory_order_acquire)) {
+                    return r;
+                }
+            }
+            auto * r = new hazard_record; // never freed, reused by the later threads
+            r->next = hazard_records.load(std::memory_order_relaxed);
+            while (not hazard_records.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {}
+            return r;
+        }
+    };
+    static thread_local owner self;
+    return *self.record;
+}
+
+/// the node is announced by some thread
+inline bool is_hazard(const void * node) noexcept {
+    for (auto * r = hazard_records.load(std::memory_order_acquire); r; r = r->next) {
+        for (auto const& slot : r->slots) {
+            if (slot.load(std::memory_order_seq_cst) == node) { return true; }
+        }
+    }
+    return false;
+}
+}// namespace detail
+
+
+/// ===== [ ATOMIC FSOME ] =====
+///@brief: An fsome<Trait> that can be replaced while the other threads keep using it, e.g. a strategy hot-swapped under the workers.
+/// The object lives in an immutable node, published through an atomic pointer (store() swaps in a new node).
+/// Readers don't lock: load() announces the node in a hazard pointer of the thread (a store and a re-check of the pointer),
+/// and the guard it returns keeps the node alive until it's gone. The replaced nodes are retired and deleted by the later stores,
+/// once no thread announces them, or by the destructor.
+///@note: the object is accessed as a `Trait const`, the calls from different threads run concurrently
+///@note: `strategy->call()` holds the guard for the duration of the full expression,
+///       keep a `load()`ed guard around to make several calls to the same object
+///@note: a thread can hold up to hazard_record::n_slots guards at a time (hazard_slots_exhausted otherwise),
+///       a guard is released on the thread that loaded it
+///@note: with an SBO in the `config` that fits the objects, a store() is a single allocation (the node)
+template <typename Trait, cfg::fsome config = cfg::fsome{}>
+class atomic_fsome {
+    struct node {
+        fsome<Trait, config> object;
+    };
+
+public:
+    using value_type = fsome<Trait, config>;
+
+    /// a pinned node, read-only access to its object
+    class guard {
+    public:
+        guard(guard && other) noexcept
+        : node_{std::exchange(other.node_, nullptr)}, slot_{std::exchange(other.slot_, nullptr)} {}
+
+        guard& operator= (guard &&) = delete;
+
+        ~guard() {
+            if (slot_) { slot_->store(nullptr, std::memory_order_release); }
+        }
+
+        auto const* operator-> () const noexcept { return node_->object.operator->(); }
+        auto const& operator* () const noexcept { return *node_->object; }
+
+        value_type const& get() const noexcept { return node_->object; }
+
+        template <typename Target>
+        const Target* try_get() const noexcept { return node_ ? node_->object.template try_get<Target>() : nullptr; }
+
+        explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    private:
+        friend class atomic_fsome;
+
+        guard(node const* n, std::atomic<const void*> * slot) noexcept : node_{n}, slot_{slot} {}
+
+        node const* node_;
+        std::atomic<const void*> * slot_;
+    };
+
+    atomic_fsome() noexcept = default;
+
+    explicit atomic_fsome(value_type object) : current_{new node{std::move(object)}} {}
+
+    template <typename T>
+    requires (not polymorphic<T> && not std::is_same_v<std::remove_cvref_t<T>, atomic_fsome>)
+    explicit atomic_fsome(T && obj) : atomic_fsome{value_type(std::forward<T>(obj))} {}
+
+    atomic_fsome(atomic_fsome const&) = delete;
+    atomic_fsome& operator= (atomic_fsome const&) = delete;
+
+    /// no load() may run concurrently with the destruction (or hold a guard past it)
+    ~atomic_fsome() {
+        delete current_.load(std::memory_order_acquire);
+        for (node * n : retired_) { delete n; }
+    }
+
+    /// pins the current object for this thread
+    guard load() const {
+        auto & slots = detail::this_thread_hazards().slots;
+        std::atomic<const void*> * slot = nullptr;
+        for (auto & s : slots) {
+            if (s.load(std::memory_order_relaxed) == nullptr) { slot = &s; break; }
+        }
+        if (not slot) { throw hazard_slots_exhausted{"vx::atomic_fsome: too many guards held by the thread"}; }
+
+        node * n = current_.load(std::memory_order_acquire);
+        while (true) {
+            if (not n) { slot->store(nullptr, std::memory_order_relaxed); return {nullptr, nullptr}; }
+            // announce, then make sure it's still the current one (otherwise a store may have missed the announcement)
+            slot->store(n, std::memory_order_seq_cst);
+            node * again = current_.load(std::memory_order_seq_cst);
+            if (again == n) { return {n, slot}; }
+            n = again;
+        }
+    }
+
+    guard operator-> () const { return load(); }
+
+    /// publishes the new object, the old one is deleted as soon as no thread is reading it
+    void store(value_type object) {
+        std::unique_ptr<node> fresh {new node{std::move(object)}};
+        std::lock_guard lock {retire_mutex_};
+        if (retired_.size() == retired_.capacity()) {
+            retired_.reserve(std::max<std::size_t>(8, 2 * retired_.size())); // so that the old node can't be lost to a push_back throwing
+        }
+        node * old = current_.exchange(fresh.release(), std::memory_order_seq_cst);
+        if (old) { retired_.push_back(old); }
+        reclaim_locked();
+    }
+
+    template <typename T>
+    requires (not polymorphic<T>)
+    void store(T && obj) { store(value_type(std::forward<T>(obj))); }
+
+    template <typename T>
+    requires (not polymorphic<T>)
+    atomic_fsome& operator= (T && obj) {
+        store(std::forward<T>(obj));
+        return *this;
+    }
+
+    /// the replaced objects still waiting for their readers
+    std::size_t retired() const {
+        std::lock_guard lock {retire_mutex_};
+        return retired_.size();
+    }
+
+    /// deletes the retired objects that are no longer read
+    void reclaim() {
+        std::lock_guard lock {retire_mutex_};
+        reclaim_locked();
+    }
+
+private:
+    void reclaim_locked() {
+        std::erase_if(retired_, [](node * n) {
+            if (detail::is_hazard(n)) { return false; }
+            delete n;
+            return true;
+        });
+    }
+
+    std::atomic<node *> current_ {nullptr};
+    mutable std::mutex retire_mutex_;
+    std::vector<node *> retired_;
+};
+
+} // namespace vx
@@ -0,0 +1,117 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "some.hpp"
+
+namespace vx {
+
+namespace detail {
+    template <typename> struct is_fsome : std::false_type {};
+
+    template <typename Trait, cfg::fsome config>
+    struct is_fsome< fsome<Trait, config> > : std::true_type {};
+}// namespace detail
+
+template <typename R>
+concept fsome_range = std::ranges::forward_range<R> 
+                   && detail::is_fsome<std::remove_cv_t<std::ranges::range_value_t<R>>>::value;
+
+
+/// ===== [ BATCHED DISPATCH ] =====
+///@brief: The elements of a range of fsome<>, grouped by their dynamic type (i.e. by vptr).
+/// Every group holds the iterators to the elements of one type, in their original order.
+/// Only the vptrs stored inline in the fsomes are read, the pointees aren't touched.
+///@note: empty fsomes are left out
+///@note: stays valid as long as the range isn't modified (assigning to the elements included)
+template <std::forward_iterator It>
+class type_groups {
+public:
+    struct group {
+        const void* vptr;          ///< identifies the dynamic type
+        std::span<It const> items; ///< iterators to the elements of that type
+    };
+
+    template <std::sentinel_for<It> S>
+    type_groups(It first, S last) {
+        // the types are few, so every element is compared against all of them, which
+        // (unlike stopping at the first match) doesn't make the branch predictor guess the type
+        std::vector<std::uint32_t> type_of;
+        std::vector<std::size_t> counts;
+        if constexpr (std::sized_sentinel_for<S, It>) { type_of.reserve(static_cast<std::size_t>(last - first)); }
+        for (auto it = first; it != last; ++it) {
+            const void* vptr = (*it).vptr();
+            std::uint32_t type = k_empty;
+            for (std::uint32_t t = 0; t < vptrs_.size(); ++t) { type = vptrs_[t] == vptr ? t : type; }
+            if (type == k_empty) [[unlikely]] {
+                if (vptr == nullptr) { type_of.push_back(k_empty); continue; }
+                type = static_cast<std::uint32_t>(vptrs_.size());
+                vptrs_.push_back(vptr);
+                counts.push_back(0);
+            }
+            ++counts[type];
+            type_of.push_back(type);
+        }
+
+        // counting sort: stable, two passes
+        std::vector<std::size_t> offsets (vptrs_.size() + 1, 0);
+        for (std::size_t t = 0; t < vptrs_.size(); ++t) { offsets[t + 1] = offsets[t] + counts[t]; }
+        order_.resize(offsets.back());
+        std::vector<std::size_t> cursor (offsets.begin(), offsets.end() - 1);
+        std::size_t index = 0;
+        for (auto it = first; it != last; ++it, ++index) {
+            if (type_of[index] != k_empty) { order_[cursor[type_of[index]]++] = it; }
+        }
+
+        groups_.reserve(vptrs_.size());
+        for (std::size_t t = 0; t < vptrs_.size(); ++t) {
+            groups_.push_back({vptrs_[t], std::span<It const>{order_}.subspan(offsets[t], counts[t])});
+        }
+    }
+
+    type_groups(type_groups const&) = delete; // the groups point into the order_
+    type_groups(type_groups &&) noexcept = default;
+    type_groups& operator= (type_groups &&) noexcept = default;
+
+    auto begin() const noexcept { return groups_.begin(); }
+    auto end() const noexcept { return groups_.end(); }
+    std::size_t size() const noexcept { return groups_.size(); }
+    group const& operator[] (std::size_t index) const noexcept { return groups_[index]; }
+
+private:
+    static constexpr std::uint32_t k_empty = ~std::uint32_t{0};
+
+    std::vector<const void*> vptrs_;
+    std::vector<It> order_;
+    std::vector<group> groups_;
+};
+
+
+/// groups the fsomes of the range by their dynamic type, see type_groups
+template <fsome_range R>
+auto group_by_type(R & range) {
+    return type_groups<std::ranges::iterator_t<R>>{std::ranges::begin(range), std::ranges::end(range)};
+}
+
+/// calls f on every element, all the elements of one type back to back, so the indirect branches stay predictable
+template <std::forward_iterator It, typename F>
+void for_each_batched(type_groups<It> const& groups, F && f) {
+    for (auto const& group : groups) {
+        for (auto const& it : group.items) { f(*it); }
+    }
+}
+
+template <fsome_range R, typename F>
+void for_each_batched(R && range, F && f) {
+    for_each_batched(group_by_type(range), std::forward<F>(f));
+}
+
+} // namespace vx
@@ -0,0 +1,116 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// A "request" builds a batch of short-lived shapes, calls them and throws them all away.
+/// Compares the plain heap path (storage_for<Trait, 0, ...>: new + virtual dtor + delete per object)
+/// to the same objects bump-allocated in a vx::arena, that skips the cleanup of the trivially destructible payloads.
+///
+/// g++ -std=c++20 -O2 bench_arena.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "shapes.hpp"
+
+using namespace bench;
+
+static void build_and_call_classic(benchmark::State& state) {
+    std::vector<std::unique_ptr<IShape>> shapes;
+    shapes.reserve(state.range(0));
+    for (auto _ : state) {
+        std::mt19937 mt {};
+        for (auto i = 0; i < state.range(0); ++i) {
+            if (mt() % 2 == 0) {
+                shapes.push_back(std::make_unique<VCircle>(i));
+            } else {
+                shapes.push_back(std::make_unique<VSquare>(i));
+            }
+        }
+        std::size_t sides = 0;
+        for (auto && shape : shapes) { sides += shape->info(); }
+        benchmark::DoNotOptimize(sides);
+        shapes.clear();
+    }
+}
+
+template <typename Some>
+static void build_and_call(std::vector<Some> & shapes, benchmark::State& state) {
+    std::mt19937 mt {};
+    for (auto i = 0; i < state.range(0); ++i) {
+        if (mt() % 2 == 0) {
+            shapes.emplace_back(Circle{i});
+        } else {
+            shapes.emplace_back(Square{i});
+        }
+    }
+    std::size_t sides = 0;
+    for (auto && shape : shapes) { sides += shape->info(); }
+    benchmark::DoNotOptimize(sides);
+    shapes.clear();
+}
+
+/// storage_for<Shape, 0, ...>: every object is new'd and deleted (after a virtual dtor call)
+static void build_and_call_some_heap(benchmark::State& state) {
+    std::vector<vx::some<Shape, vx::cfg::some{.sbo{0}}>> shapes;
+    shapes.reserve(state.range(0));
+    for (auto _ : state) {
+        build_and_call(shapes, state);
+    }
+}
+
+/// the same, but every object goes through the (default) memory resource, as a baseline for the arena
+static void build_and_call_some_pmr(benchmark::State& state) {
+    std::vector<vx::some<Shape, vx::cfg::some{.sbo{0}, .pmr=true}>> shapes;
+    shapes.reserve(state.range(0));
+    for (auto _ : state) {
+        build_and_call(shapes, state);
+    }
+}
+
+static void build_and_call_some_arena(benchmark::State& state) {
+    std::vector<vx::some<Shape, vx::cfg::some{.sbo{0}, .pmr=true}>> shapes;
+    shapes.reserve(state.range(0));
+    for (auto _ : state) {
+        vx::arena request {};
+        build_and_call(shapes, state);
+    }
+}
+
+/// the arena starts off with a buffer on the stack and never goes upstream
+static void build_and_call_some_arena_on_stack(benchmark::State& state) {
+    std::vector<vx::some<Shape, vx::cfg::some{.sbo{0}, .pmr=true}>> shapes;
+    shapes.reserve(state.range(0));
+    alignas(std::max_align_t) std::byte buffer[64 * 1024];
+    for (auto _ : state) {
+        vx::arena request {buffer, sizeof(buffer)};
+        build_and_call(shapes, state);
+    }
+}
+
+static void build_and_call_fsome_heap(benchmark::State& state) {
+    std::vector<vx::fsome<Shape>> shapes;
+    shapes.reserve(state.range(0));
+    for (auto _ : state) {
+        build_and_call(shapes, state);
+    }
+}
+
+static void build_and_call_fsome_arena(benchmark::State& state) {
+    std::vector<vx::fsome<Shape, vx::cfg::fsome{.pmr=true}>> shapes;
+    shapes.reserve(state.range(0));
+    for (auto _ : state) {
+        vx::arena request {};
+        build_and_call(shapes, state);
+    }
+}
+
+BENCHMARK(build_and_call_classic)->Arg(1'000);
+BENCHMARK(build_and_call_some_heap)->Arg(1'000);
+BENCHMARK(build_and_call_some_pmr)->Arg(1'000);
+BENCHMARK(build_and_call_some_arena)->Arg(1'000);
+BENCHMARK(build_and_call_some_arena_on_stack)->Arg(1'000);
+BENCHMARK(build_and_call_fsome_heap)->Arg(1'000);
+BENCHMARK(build_and_call_fsome_arena)->Arg(1'000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The areas of 1M randomly mixed Circles and Squares (the README shapes, see examples/shapes.hpp) into a float array:
+/// the virtual area() per shape over std::vector<some<>> and poly_collection, the devirtualized area() per shape
+/// of the listed types, and the batch hook: one vectorized area_batch per segment (poly_collection::transform).
+///
+/// g++ -std=c++20 -O2 bench_batch_kernels.cpp -lbenchmark -lpthread      (-march=native for the 256-bit registers)
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../examples/shapes.hpp"
+
+using namespace shapes;
+
+static constexpr std::size_t N = 1'000'000;
+
+template <typename Container>
+static Container make_shapes() {
+    Container shapes;
+    std::mt19937 mt {}; // default initialized for all tests
+    std::uniform_real_distribution<float> size {0.5f, 10.f};
+    for (std::size_t i = 0; i < N; ++i) {
+        if constexpr (requires { shapes.insert(Circle{}); }) {
+            if (mt() % 2 == 0) { shapes.insert(Circle{size(mt)}); } else { shapes.insert(Square{size(mt)}); }
+        } else {
+            if (mt() % 2 == 0) { shapes.emplace_back(Circle{size(mt)}); } else { shapes.emplace_back(Square{size(mt)}); }
+        }
+    }
+    return shapes;
+}
+
+static void virtual_area_some(benchmark::State& state) {
+    auto const shapes = make_shapes<std::vector<vx::some<Shape>>>();
+    std::vector<float> areas(N);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < N; ++i) { areas[i] = shapes[i]->area(); }
+        benchmark::DoNotOptimize(areas.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void virtual_area_collection(benchmark::State& state) {
+    auto const shapes = make_shapes<vx::poly_collection<Shape>>();
+    std::vector<float> areas(N);
+    for (auto _ : state) {
+        shapes.transform(std::span{areas}, area{});
+        benchmark::DoNotOptimize(areas.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void devirtualized_area_collection(benchmark::State& state) {
+    auto const shapes = make_shapes<vx::poly_collection<Shape>>();
+    std::vector<float> areas(N);
+    for (auto _ : state) {
+        shapes.transform<Circle, Square>(std::span{areas}, [](auto const& shape) { return shape.area(); });
+        benchmark::DoNotOptimize(areas.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void batch_area_collection(benchmark::State& state) {
+    auto const shapes = make_shapes<vx::poly_collection<Shape>>();
+    std::vector<float> areas(N);
+    for (auto _ : state) {
+        shapes.transform<Circle, Square>(std::span{areas}, area{});
+        benchmark::DoNotOptimize(areas.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(virtual_area_some)->Unit(benchmark::kMicrosecond);
+BENCHMARK(virtual_area_collection)->Unit(benchmark::kMicrosecond);
+BENCHMARK(devirtualized_area_collection)->Unit(benchmark::kMicrosecond);
+BENCHMARK(batch_area_collection)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The info() + bump() loop of quick_bench_fsome.cpp over randomly mixed Circles and Squares,
+/// plain vs. batched by dynamic type (vx::for_each_batched)
+///
+/// g++ -std=c++20 -O2 bench_batched.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../batched.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+static constexpr std::size_t N = 100'000;
+
+template <vx::cfg::fsome config>
+static auto make_shapes() {
+    std::vector<vx::fsome<Shape, config>> shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) {
+            shapes.emplace_back(Circle{});
+        } else {
+            shapes.emplace_back(Square{});
+        }
+    }
+    return shapes;
+}
+
+template <vx::cfg::fsome config>
+static void iterate_and_call_fsome(benchmark::State& state) {
+    auto shapes = make_shapes<config>();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape->info();
+            shape->bump();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+/// groups the shapes on every pass
+template <vx::cfg::fsome config>
+static void iterate_and_call_fsome_batched(benchmark::State& state) {
+    auto shapes = make_shapes<config>();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        vx::for_each_batched(shapes, [&](auto & shape) {
+            sides += shape->info();
+            shape->bump();
+        });
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+/// groups the shapes once, the collection doesn't change between the passes
+template <vx::cfg::fsome config>
+static void iterate_and_call_fsome_batched_reused(benchmark::State& state) {
+    auto shapes = make_shapes<config>();
+    auto groups = vx::group_by_type(shapes);
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        vx::for_each_batched(groups, [&](auto & shape) {
+            sides += shape->info();
+            shape->bump();
+        });
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+static void group_by_type(benchmark::State& state) {
+    auto shapes = make_shapes<vx::cfg::fsome{}>();
+    for (auto _ : state) {
+        auto groups = vx::group_by_type(shapes);
+        benchmark::DoNotOptimize(groups);
+    }
+}
+
+BENCHMARK(iterate_and_call_fsome<vx::cfg::fsome{}>);
+BENCHMARK(iterate_and_call_fsome_batched<vx::cfg::fsome{}>);
+BENCHMARK(iterate_and_call_fsome_batched_reused<vx::cfg::fsome{}>);
+BENCHMARK(iterate_and_call_fsome<vx::cfg::fsome{.sbo{16}}>);
+BENCHMARK(iterate_and_call_fsome_batched<vx::cfg::fsome{.sbo{16}}>);
+BENCHMARK(iterate_and_call_fsome_batched_reused<vx::cfg::fsome{.sbo{16}}>);
+BENCHMARK(group_by_type);
+
+BENCHMARK_MAIN();
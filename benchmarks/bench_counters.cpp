@@ -0,0 +1,119 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The iterate-and-call scenario of quick_bench_some.cpp with the hardware counters (perf_counters.hpp) next to the time:
+/// cycles, instructions, L1d/LLC misses, branch mispredictions and dTLB misses per iteration (a pass over all the shapes),
+/// plus the instructions per cycle. That's the "why" behind the wall-clock numbers:
+/// the classic baseline and some without SBO chase a pointer per element (the cache and dTLB misses),
+/// fsome keeps the vptr inline (one load less per call), SBO keeps the object next to it.
+///
+/// Run with N = 1'000 (everything fits in L1/L2) and N = 1'000'000 (it doesn't).
+/// Without the counters (see perf_counters.hpp) only the time is reported and the reason is printed once.
+///
+/// g++ -std=c++20 -O2 bench_counters.cpp -lbenchmark -lpthread
+/// (the counters need perf_event_paranoid <= 2, or CAP_PERFMON)
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+static perf_counters & counters() {
+    static perf_counters instance;
+    return instance;
+}
+
+/// (*shape).info() for every shape, the `perf_counters` measuring the whole timed loop
+template <typename Container>
+static void measure(benchmark::State& state, Container const& shapes) {
+    auto & perf = counters();
+    perf.start();
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto && shape : shapes) {
+            sum += (*shape).info();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    auto const values = perf.stop();
+
+    if (not perf.available()) { return; }
+    for (unsigned e = 0; e < perf_counters::n_events; ++e) {
+        if (perf.available(perf_counters::event(e))) {
+            state.counters[perf_counters::names[e]] = benchmark::Counter(values[e], benchmark::Counter::kAvgIterations);
+        }
+    }
+    if (perf.available(perf_counters::instructions) && values[perf_counters::cycles] > 0) {
+        state.counters["IPC"] = values[perf_counters::instructions] / values[perf_counters::cycles];
+    }
+}
+
+/// Circles and Squares in the random order of quick_bench_some.cpp
+template <typename Container>
+static Container make_shapes(std::size_t n) {
+    Container shapes;
+    shapes.reserve(n);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < n; ++i) {
+        if (mt() % 2 == 0) { shapes.emplace_back(Circle{}); } else { shapes.emplace_back(Square{}); }
+    }
+    return shapes;
+}
+
+static void classic(benchmark::State& state) {
+    std::vector<std::unique_ptr<IShape>> shapes;
+    auto const n = static_cast<std::size_t>(state.range(0));
+    shapes.reserve(n);
+    std::mt19937 mt {};
+    for (std::size_t i = 0; i < n; ++i) {
+        if (mt() % 2 == 0) { shapes.push_back(std::make_unique<VCircle>()); } else { shapes.push_back(std::make_unique<VSquare>()); }
+    }
+    measure(state, shapes);
+}
+
+template <typename Some>
+static void owning(benchmark::State& state) {
+    auto const shapes = make_shapes<std::vector<Some>>(static_cast<std::size_t>(state.range(0)));
+    measure(state, shapes);
+}
+
+/// views to the Circles and Squares kept in their own vectors
+static void poly_view(benchmark::State& state) {
+    auto const n = static_cast<std::size_t>(state.range(0));
+    std::vector<Circle> circles;
+    std::vector<Square> squares;
+    std::vector<vx::some<Shape&>> shapes;
+    circles.reserve(n);
+    squares.reserve(n);
+    shapes.reserve(n);
+    std::mt19937 mt {};
+    for (std::size_t i = 0; i < n; ++i) {
+        if (mt() % 2 == 0) { shapes.emplace_back(circles.emplace_back()); } else { shapes.emplace_back(squares.emplace_back()); }
+    }
+    measure(state, shapes);
+}
+
+#define SIZES ->Arg(1'000)->Arg(1'000'000)
+
+BENCHMARK(classic) SIZES;
+BENCHMARK(owning<vx::some<Shape>>)->Name("some") SIZES;
+BENCHMARK(owning<vx::some<Shape, vx::cfg::some{.sbo{0}}>>)->Name("some_no_sbo") SIZES;
+BENCHMARK(owning<vx::fsome<Shape>>)->Name("fsome") SIZES;
+BENCHMARK(owning<vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>>)->Name("fsome_sbo") SIZES;
+BENCHMARK(poly_view) SIZES;
+
+int main(int argc, char** argv) {
+    if (not counters().available()) {
+        std::fprintf(stderr, "hardware counters unavailable (%s), reporting the time only\n", counters().why_unavailable().c_str());
+    }
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
@@ -0,0 +1,142 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Startup: a table of 100k handlers built out of the config (a name and the parameters per handler) with 64 handler types,
+/// through vx::factory (the perfect hash, the handlers constructed in place) into some<> and fsome<> (SBO),
+/// against the usual std::unordered_map<std::string, std::function<some<>(Config const&)>> registry.
+/// And the name lookups alone.
+///
+/// g++ -std=c++20 -O2 bench_factory.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../factory.hpp"
+
+struct Handler : vx::trait {
+    virtual int handle(int event) const noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Handler, T> final : vx::impl_for<Handler, T> {
+    using vx::impl_for<Handler, T>::impl_for;
+    using vx::impl_for<Handler, T>::self;
+    int handle(int event) const noexcept override { return self().handle(event); }
+};
+
+struct Config {
+    int threshold = 0;
+    int scale = 1;
+};
+
+template <std::size_t I>
+struct Filter {
+    int threshold;
+    int scale;
+    explicit Filter(Config const& config) : threshold{config.threshold}, scale{config.scale} {}
+    int handle(int event) const noexcept { return event > threshold ? event * scale + int(I) : 0; }
+};
+
+static constexpr std::size_t n_types = 64;
+static constexpr std::size_t N = 100'000;
+
+/// "filter_00" .. "filter_63"
+template <std::size_t I>
+constexpr auto filter_name = [] {
+    vx::fixed_string<10> name {"filter_00"};
+    name.chars[7] = char('0' + I / 10);
+    name.chars[8] = char('0' + I % 10);
+    return name;
+}();
+
+template <std::size_t... Is>
+auto make_factory(std::index_sequence<Is...>) -> vx::factory<Handler, vx::named<filter_name<Is>, Filter<Is>>...>;
+
+using filters = decltype(make_factory(std::make_index_sequence<n_types>{}));
+
+using some = vx::some<Handler>;
+using fsome_sbo = vx::fsome<Handler, vx::cfg::fsome{.sbo{16}}>;
+
+/// the config: the names and the parameters of the handlers, in the order they are created
+static std::vector<std::pair<std::string, Config>> const& config() {
+    static auto const entries = [] {
+        std::vector<std::pair<std::string, Config>> result;
+        result.reserve(N);
+        std::mt19937 mt {}; // default initialized for all tests
+        for (std::size_t i = 0; i < N; ++i) {
+            result.emplace_back(std::string{filters::names()[mt() % n_types]}, Config{int(mt() % 100), int(mt() % 4)});
+        }
+        return result;
+    }();
+    return entries;
+}
+
+template <typename Object>
+static void build_with_factory(benchmark::State& state) {
+    auto const& entries = config();
+    for (auto _ : state) {
+        std::vector<Object> handlers(entries.size());
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            filters::make_into(handlers[i], entries[i].first, entries[i].second);
+        }
+        benchmark::DoNotOptimize(handlers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t... Is>
+static auto make_registry(std::index_sequence<Is...>) {
+    std::unordered_map<std::string, std::function<some(Config const&)>> registry;
+    ((registry[std::string{filter_name<Is>.view()}] = [](Config const& c) { return some{Filter<Is>{c}}; }), ...);
+    return registry;
+}
+
+static void build_with_unordered_map(benchmark::State& state) {
+    auto const& entries = config();
+    auto const registry = make_registry(std::make_index_sequence<n_types>{});
+    for (auto _ : state) {
+        std::vector<some> handlers;
+        handlers.reserve(entries.size());
+        for (auto const& [name, parameters] : entries) {
+            handlers.push_back(registry.at(name)(parameters));
+        }
+        benchmark::DoNotOptimize(handlers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void lookup_perfect_hash(benchmark::State& state) {
+    auto const& entries = config();
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (auto const& entry : entries) { sum += filters::index_of(entry.first); }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void lookup_unordered_map(benchmark::State& state) {
+    auto const& entries = config();
+    std::unordered_map<std::string, std::size_t> indices;
+    for (std::size_t i = 0; i < n_types; ++i) { indices.emplace(filters::names()[i], i); }
+    for (auto _ : state) {
+        std::size_t sum = 0;
+        for (auto const& entry : entries) { sum += indices.find(entry.first)->second; }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(build_with_factory<some>)->Unit(benchmark::kMillisecond);
+BENCHMARK(build_with_factory<fsome_sbo>)->Unit(benchmark::kMillisecond);
+BENCHMARK(build_with_unordered_map)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(lookup_perfect_hash)->Unit(benchmark::kMillisecond);
+BENCHMARK(lookup_unordered_map)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Calls through a type-erased int(int) callable (a small lambda with a bit of state): one in a call-heavy loop
+/// and a list of callbacks called one after another.
+/// fn_some's inline invoker vs. std::function, std::move_only_function and the vtable of (f)some<Callable<int(int)>>
+///
+/// g++ -std=c++23 -O2 bench_fn_some.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../fn_some.hpp"
+
+/// The simplified std::function from the README
+template <typename Signature>
+struct Callable;
+
+template <typename R, typename... Args>
+struct Callable<R(Args...)> : vx::trait {
+    R operator() (Args... args) { return call(args...); }
+private:
+    virtual R call(Args... args) = 0;
+};
+
+template <typename F, typename R, typename... Args>
+struct vx::impl<Callable<R(Args...)>, F> final : vx::impl_for<Callable<R(Args...)>, F> {
+    using vx::impl_for<Callable<R(Args...)>, F>::impl_for;
+    R call(Args... args) override { return vx::poly {this}->operator()(args...); }
+};
+
+static constexpr int N = 1'000;
+
+/// picked at runtime, so that the call can't be devirtualized
+template <typename Function>
+static Function make_function() {
+    std::mt19937 mt {}; // default initialized for all tests
+    int const offset = static_cast<int>(mt() % 7);
+    if (mt() % 2 == 0) {
+        return [offset](int x) { return x + offset; };
+    } else {
+        return [offset](int x) { return x ^ offset; };
+    }
+}
+
+template <typename Function>
+static void call_loop(benchmark::State& state) {
+    auto f = make_function<Function>();
+    for (auto _ : state) {
+        int sum = 0;
+        for (int i = 0; i < N; ++i) { sum += f(i); }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+/// a list of callbacks, each one called once
+template <typename Function>
+static void call_each(benchmark::State& state) {
+    std::vector<Function> callbacks;
+    std::mt19937 mt {}; // default initialized for all tests
+    for (int i = 0; i < 10 * N; ++i) {
+        if (mt() % 2 == 0) {
+            callbacks.emplace_back([i](int x) { return x + i; });
+        } else {
+            callbacks.emplace_back([i](int x) { return x ^ i; });
+        }
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto & f : callbacks) { sum += f(sum & 0xff); }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(call_loop<std::function<int(int)>>);
+#if defined(__cpp_lib_move_only_function)
+BENCHMARK(call_loop<std::move_only_function<int(int)>>);
+#endif
+BENCHMARK(call_loop<vx::fsome<Callable<int(int)>>>);
+BENCHMARK(call_loop<vx::fsome<Callable<int(int)>, vx::cfg::fsome{.sbo{16}}>>);
+BENCHMARK(call_loop<vx::some<Callable<int(int)>>>);
+BENCHMARK(call_loop<vx::fn_some<int(int)>>);
+
+BENCHMARK(call_each<std::function<int(int)>>);
+#if defined(__cpp_lib_move_only_function)
+BENCHMARK(call_each<std::move_only_function<int(int)>>);
+#endif
+BENCHMARK(call_each<vx::fsome<Callable<int(int)>>>);
+BENCHMARK(call_each<vx::fsome<Callable<int(int)>, vx::cfg::fsome{.sbo{16}}>>);
+BENCHMARK(call_each<vx::some<Callable<int(int)>>>);
+BENCHMARK(call_each<vx::fn_some<int(int)>>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,109 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Cold start of a read-only table of 1M shapes: the file mapped with vx::mapped_store (the views are made on access)
+/// against the streaming restore of the same shapes through vx::type_registry into some<> and fsome<> (SBO),
+/// the load alone and the load followed by one pass over all the shapes.
+///
+/// g++ -std=c++20 -O2 bench_mapped_store.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../mapped_store.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+using some = vx::some<Shape>;
+using fsome_sbo = vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>;
+
+static constexpr std::size_t N = 1'000'000;
+
+static vx::type_registry<Shape> const& registry() {
+    static auto const instance = [] {
+        vx::type_registry<Shape> r;
+        r.add<Circle>(1).add<Square>(2).add<Polygon>(3);
+        return r;
+    }();
+    return instance;
+}
+
+/// the same shapes in both formats, written once
+struct files {
+    std::string mapped = "bench_mapped_store.vxstore";
+    std::string streamed = "bench_mapped_store.vxstream";
+
+    files() {
+        std::vector<some> shapes;
+        shapes.reserve(N);
+        std::mt19937 mt {}; // default initialized for all tests
+        for (std::size_t i = 0; i < N; ++i) {
+            auto const kind = mt() % 4;
+            if (kind == 0) { shapes.emplace_back(Polygon{}); }
+            else if (kind == 1) { shapes.emplace_back(Circle{}); }
+            else { shapes.emplace_back(Square{}); }
+        }
+        std::ofstream mapped_file {mapped, std::ios::binary};
+        vx::binary_writer mapped_out {mapped_file};
+        vx::mapped_store<const Shape>::write(mapped_out, registry(), shapes);
+        std::ofstream streamed_file {streamed, std::ios::binary};
+        vx::binary_writer streamed_out {streamed_file};
+        registry().write(streamed_out, shapes);
+    }
+
+    ~files() {
+        std::remove(mapped.c_str());
+        std::remove(streamed.c_str());
+    }
+};
+
+static files const& data() {
+    static files const instance;
+    return instance;
+}
+
+template <bool iterate>
+static void mapped_open(benchmark::State& state) {
+    data();
+    for (auto _ : state) {
+        auto store = vx::mapped_store<const Shape>::open(data().mapped, registry());
+        std::size_t sides = 0;
+        if constexpr (iterate) {
+            for (std::size_t i = 0; i < store.size(); ++i) { sides += store[i]->info(); }
+        }
+        benchmark::DoNotOptimize(sides);
+        benchmark::DoNotOptimize(store);
+    }
+}
+
+template <typename Object, bool iterate>
+static void stream_restore(benchmark::State& state) {
+    data();
+    for (auto _ : state) {
+        std::ifstream file {data().streamed, std::ios::binary};
+        vx::binary_reader in {file};
+        std::vector<Object> shapes;
+        registry().read(in, shapes);
+        std::size_t sides = 0;
+        if constexpr (iterate) {
+            for (auto const& shape : shapes) { sides += shape->info(); }
+        }
+        benchmark::DoNotOptimize(sides);
+        benchmark::DoNotOptimize(shapes.data());
+    }
+}
+
+BENCHMARK(mapped_open<false>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_restore<some, false>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_restore<fsome_sbo, false>)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(mapped_open<true>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_restore<some, true>)->Unit(benchmark::kMillisecond);
+BENCHMARK(stream_restore<fsome_sbo, true>)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
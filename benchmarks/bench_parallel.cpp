@@ -0,0 +1,126 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// A per-tick update (bump()) and a reduction (the sum of info()) over 1M randomly mixed Circles and Squares:
+/// the sequential loop against vx::parallel_for_each / vx::parallel_transform_reduce on a vx::thread_pool
+/// of 1, 2, 4, ... threads (up to the cores of the machine), over fsome<>, some<>, poly_collection
+/// and the fsome<>s grouped by type once (vx::type_groups, the chunks of a single type).
+///
+/// g++ -std=c++20 -O2 bench_parallel.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../parallel.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+static constexpr std::size_t N = 1'000'000;
+
+template <typename Container>
+static Container make_shapes() {
+    Container shapes;
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if constexpr (requires { shapes.insert(Circle{}); }) {
+            if (mt() % 2 == 0) { shapes.insert(Circle{}); } else { shapes.insert(Square{}); }
+        } else {
+            if (mt() % 2 == 0) { shapes.emplace_back(Circle{}); } else { shapes.emplace_back(Square{}); }
+        }
+    }
+    return shapes;
+}
+
+using fsomes = std::vector<vx::fsome<Shape>>;
+using somes = std::vector<vx::some<Shape>>;
+using collection = vx::poly_collection<Shape>;
+
+template <typename Container>
+static void sequential_update(benchmark::State& state) {
+    auto shapes = make_shapes<Container>();
+    for (auto _ : state) {
+        for (auto && shape : shapes) { shape->bump(); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Container>
+static void parallel_update(benchmark::State& state) {
+    auto shapes = make_shapes<Container>();
+    vx::thread_pool pool {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        if constexpr (std::is_same_v<Container, collection>) {
+            vx::parallel_for_each<Circle, Square>(pool, shapes, [](auto & shape) { shape.bump(); });
+        } else {
+            vx::parallel_for_each(pool, shapes, [](auto & shape) { shape->bump(); });
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void parallel_update_grouped(benchmark::State& state) {
+    auto shapes = make_shapes<fsomes>();
+    auto const groups = vx::group_by_type(shapes);
+    vx::thread_pool pool {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        vx::parallel_for_each(pool, groups, [](auto & shape) { shape->bump(); });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Container>
+static void sequential_reduce(benchmark::State& state) {
+    auto const shapes = make_shapes<Container>();
+    for (auto _ : state) {
+        long sides = 0;
+        for (auto const& shape : shapes) { sides += shape->info(); }
+        benchmark::DoNotOptimize(sides);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Container>
+static void parallel_reduce(benchmark::State& state) {
+    auto const shapes = make_shapes<Container>();
+    vx::thread_pool pool {static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state) {
+        long sides = 0;
+        if constexpr (std::is_same_v<Container, collection>) {
+            sides = vx::parallel_transform_reduce<Circle, Square>(pool, shapes, 0L, std::plus{},
+                                                                 [](auto const& shape) { return long{shape.info()}; });
+        } else {
+            sides = vx::parallel_transform_reduce(pool, shapes, 0L, std::plus{},
+                                                  [](auto const& shape) { return long{shape->info()}; });
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void threads(benchmark::internal::Benchmark * b) {
+    auto const cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned n = 1; n < cores; n *= 2) { b->Arg(n); }
+    b->Arg(cores);
+}
+
+BENCHMARK(sequential_update<fsomes>)->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_update<fsomes>)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(parallel_update_grouped)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(sequential_update<somes>)->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_update<somes>)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(parallel_update<collection>)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK(sequential_reduce<fsomes>)->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_reduce<fsomes>)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(sequential_reduce<somes>)->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_reduce<somes>)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(parallel_reduce<collection>)->Apply(threads)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
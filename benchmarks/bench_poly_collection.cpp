@@ -0,0 +1,106 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The info() + bump() loop of quick_bench_fsome.cpp over randomly mixed Circles and Squares,
+/// compared to the same shapes kept segregated by type in a vx::poly_collection
+///
+/// g++ -std=c++20 -O2 bench_poly_collection.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../poly_collection.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+static constexpr std::size_t N = 100'000;
+
+static void iterate_and_call_classic(benchmark::State& state) {
+    std::vector<std::unique_ptr<IShape>> shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) {
+            shapes.push_back(std::make_unique<VCircle>());
+        } else {
+            shapes.push_back(std::make_unique<VSquare>());
+        }
+    }
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape->info();
+            shape->bump();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+static void iterate_and_call_fsome(benchmark::State& state) {
+    std::vector<vx::fsome<Shape>> shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {};
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) {
+            shapes.emplace_back(Circle{});
+        } else {
+            shapes.emplace_back(Square{});
+        }
+    }
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape->info();
+            shape->bump();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+static vx::poly_collection<Shape> make_collection() {
+    vx::poly_collection<Shape> shapes;
+    std::mt19937 mt {};
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) {
+            shapes.emplace<Circle>();
+        } else {
+            shapes.emplace<Square>();
+        }
+    }
+    return shapes;
+}
+
+/// every segment goes through Trait&: a virtual call per element, but the calls come in runs of the same type
+static void iterate_and_call_poly_collection_virtual(benchmark::State& state) {
+    auto shapes = make_collection();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        shapes.for_each([&](Shape & shape) {
+            sides += shape.info();
+            shape.bump();
+        });
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+/// the types are listed: direct, inlinable calls
+static void iterate_and_call_poly_collection_devirtualized(benchmark::State& state) {
+    auto shapes = make_collection();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        shapes.for_each<Circle, Square>([&](auto & shape) {
+            sides += shape.info();
+            shape.bump();
+        });
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+BENCHMARK(iterate_and_call_classic);
+BENCHMARK(iterate_and_call_fsome);
+BENCHMARK(iterate_and_call_poly_collection_virtual);
+BENCHMARK(iterate_and_call_poly_collection_devirtualized);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,99 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The iterate-and-call scenarios of quick_bench_some.cpp and quick_bench_fsome.cpp,
+/// with the randomly mixed Circles and Squares stored contiguously in a vx::poly_vector
+///
+/// g++ -std=c++20 -O2 bench_poly_vector.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../poly_vector.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+/// poly_vector yields Trait& directly, adapt it to the `(*shape)` of the other containers
+struct poly_vector_of_shapes : vx::poly_vector<Shape> {
+    struct ref {
+        Shape * shape;
+        Shape & operator*() const noexcept { return *shape; }
+    };
+    struct iterator {
+        vx::poly_vector<Shape>::iterator it;
+        ref operator*() const noexcept { return {&*it}; }
+        iterator& operator++() noexcept { ++it; return *this; }
+        bool operator==(iterator const&) const = default;
+    };
+    iterator begin() noexcept { return {vx::poly_vector<Shape>::begin()}; }
+    iterator end() noexcept { return {vx::poly_vector<Shape>::end()}; }
+};
+
+using classic = std::vector<std::unique_ptr<IShape>>;
+using some = std::vector<vx::some<Shape>>;
+using some_no_sbo = std::vector<vx::some<Shape, vx::cfg::some{.sbo{0}}>>;
+using fsome = std::vector<vx::fsome<Shape>>;
+using fsome_sbo = std::vector<vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>>;
+
+template <typename Container, typename Other = Square>
+static Container make_shapes(std::size_t n) {
+    Container shapes;
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < n; ++i) {
+        bool const circle = mt() % 2 == 0;
+        if constexpr (std::is_same_v<Container, classic>) {
+            if (circle) { shapes.push_back(std::make_unique<VCircle>()); } else { shapes.push_back(std::make_unique<VSquare>()); }
+        } else if constexpr (std::is_same_v<Container, poly_vector_of_shapes>) {
+            if (circle) { shapes.template emplace_back<Circle>(); } else { shapes.template emplace_back<Other>(); }
+        } else {
+            if (circle) { shapes.emplace_back(Circle{}); } else { shapes.emplace_back(Other{}); }
+        }
+    }
+    return shapes;
+}
+
+/// quick_bench_some.cpp: N = 1'000'000, info()
+template <typename Container, typename Other = Square>
+static void iterate_and_call(benchmark::State& state) {
+    auto shapes = make_shapes<Container, Other>(1'000'000);
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += (*shape).info();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+/// quick_bench_fsome.cpp: N = 100'000, info() + bump()
+template <typename Container>
+static void iterate_call_and_bump(benchmark::State& state) {
+    auto shapes = make_shapes<Container>(100'000);
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += (*shape).info();
+            (*shape).bump();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+BENCHMARK(iterate_and_call<classic>);
+BENCHMARK(iterate_and_call<some>);
+BENCHMARK(iterate_and_call<some_no_sbo>);
+BENCHMARK(iterate_and_call<poly_vector_of_shapes>);
+
+BENCHMARK(iterate_call_and_bump<classic>);
+BENCHMARK(iterate_call_and_bump<fsome>);
+BENCHMARK(iterate_call_and_bump<fsome_sbo>);
+BENCHMARK(iterate_call_and_bump<poly_vector_of_shapes>);
+
+/// the Squares replaced with the Polygons, that don't fit into the SBO of some<>
+BENCHMARK(iterate_and_call<some, Polygon>);
+BENCHMARK(iterate_and_call<fsome, Polygon>);
+BENCHMARK(iterate_and_call<poly_vector_of_shapes, Polygon>);
+
+BENCHMARK_MAIN();
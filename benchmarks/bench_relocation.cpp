@@ -0,0 +1,68 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Moving small trivially copyable payloads around: vector growth and std::sort over a vector<some<Shape>>.
+/// The Square is trivially relocatable and is moved with a memcpy, the Sticky one is just as small
+/// but has a user-provided move constructor, so it takes the virtual do_action call
+///
+/// g++ -std=c++20 -O2 bench_relocation.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "shapes.hpp"
+
+using namespace bench;
+
+struct Sticky {
+    int side_ = 0;
+    Sticky(int side) noexcept : side_{side} {}
+    Sticky(Sticky && other) noexcept : side_{other.side_} {}
+    Sticky(Sticky const& other) noexcept : side_{other.side_} {}
+    int info() const noexcept { return side_; }
+    void bump() noexcept { side_ += 1; }
+};
+
+static constexpr std::size_t N = 100'000;
+
+template <typename Some, typename T>
+static void vector_growth(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<Some> shapes;
+        for (std::size_t i = 0; i < N; ++i) {
+            shapes.emplace_back(T{static_cast<int>(i)});
+        }
+        benchmark::DoNotOptimize(shapes.data());
+    }
+}
+
+template <typename Some, typename T>
+static void sort(benchmark::State& state) {
+    std::vector<Some> shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) { shapes.emplace_back(T{static_cast<int>(mt() % N)}); }
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto copy = shapes;
+        state.ResumeTiming();
+        std::sort(copy.begin(), copy.end(), [](auto const& a, auto const& b) { return a->info() < b->info(); });
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+using some = vx::some<Shape>;
+using fsome = vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>; // the default fsome is heap-only
+
+BENCHMARK(vector_growth<some, Sticky>);
+BENCHMARK(vector_growth<some, Square>);
+BENCHMARK(vector_growth<fsome, Sticky>);
+BENCHMARK(vector_growth<fsome, Square>);
+BENCHMARK(sort<some, Sticky>);
+BENCHMARK(sort<some, Square>);
+BENCHMARK(sort<fsome, Sticky>);
+BENCHMARK(sort<fsome, Square>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Snapshot and restore of 1M shapes through vx::type_registry, from and to memory (a stringstream),
+/// so that the bytes per second are the cost of the restore itself: the stream is the upper bound.
+/// Against a memcpy of the stream (the disk speed, at best) and a hand-written factory (a switch over the ids).
+///
+/// g++ -std=c++20 -O2 bench_serialization.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../serialization.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+using some = vx::some<Shape>;
+using fsome = vx::fsome<Shape>;
+using fsome_sbo = vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>;
+using pmr_some = vx::some<Shape, vx::cfg::some{.sbo{0}, .pmr = true}>;
+
+static constexpr std::size_t N = 1'000'000;
+
+static vx::type_registry<Shape> const& registry() {
+    static auto const instance = [] {
+        vx::type_registry<Shape> r;
+        r.add<Circle>(1).add<Square>(2).add<Polygon>(3);
+        return r;
+    }();
+    return instance;
+}
+
+static std::string const& snapshot() {
+    static std::string const bytes = [] {
+        std::vector<some> shapes;
+        shapes.reserve(N);
+        std::mt19937 mt {}; // default initialized for all tests
+        for (std::size_t i = 0; i < N; ++i) {
+            auto const kind = mt() % 4;
+            if (kind == 0) { shapes.emplace_back(Polygon{}); }
+            else if (kind == 1) { shapes.emplace_back(Circle{}); }
+            else { shapes.emplace_back(Square{}); }
+        }
+        std::ostringstream stream;
+        vx::binary_writer out {stream};
+        registry().write(out, shapes);
+        return std::move(stream).str();
+    }();
+    return bytes;
+}
+
+static void copy_bytes(benchmark::State& state) {
+    auto const& bytes = snapshot();
+    std::string copy(bytes.size(), '\0');
+    for (auto _ : state) {
+        std::memcpy(copy.data(), bytes.data(), bytes.size());
+        benchmark::DoNotOptimize(copy.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+template <typename Object>
+static void write(benchmark::State& state) {
+    std::vector<Object> shapes;
+    {
+        std::istringstream stream {snapshot()};
+        vx::binary_reader in {stream};
+        registry().read(in, shapes);
+    }
+    for (auto _ : state) {
+        std::ostringstream stream;
+        vx::binary_writer out {stream};
+        registry().write(out, shapes);
+        benchmark::DoNotOptimize(stream);
+    }
+    state.SetBytesProcessed(state.iterations() * snapshot().size());
+}
+
+template <typename Object>
+static void read(benchmark::State& state) {
+    for (auto _ : state) {
+        std::istringstream stream {snapshot()};
+        vx::binary_reader in {stream};
+        std::vector<Object> shapes;
+        registry().read(in, shapes);
+        benchmark::DoNotOptimize(shapes.data());
+    }
+    state.SetBytesProcessed(state.iterations() * snapshot().size());
+}
+
+/// the arena is released as a whole, no per-object deallocation
+static void read_into_arena(benchmark::State& state) {
+    for (auto _ : state) {
+        vx::arena scope {};
+        std::istringstream stream {snapshot()};
+        vx::binary_reader in {stream};
+        std::vector<pmr_some> shapes;
+        registry().read(in, shapes);
+        benchmark::DoNotOptimize(shapes.data());
+    }
+    state.SetBytesProcessed(state.iterations() * snapshot().size());
+}
+
+/// what it replaces: the ids are known to a switch, the objects are built by the factory functions
+template <typename T>
+static some make_from(vx::binary_reader & in) { return some{in.read<T>()}; }
+
+static void read_hand_written_factory(benchmark::State& state) {
+    for (auto _ : state) {
+        std::istringstream stream {snapshot()};
+        vx::binary_reader in {stream};
+        std::vector<some> shapes;
+        auto const count = in.read<std::uint64_t>();
+        shapes.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            switch (in.read<std::uint32_t>()) {
+                case 1: shapes.push_back(make_from<Circle>(in)); break;
+                case 2: shapes.push_back(make_from<Square>(in)); break;
+                case 3: shapes.push_back(make_from<Polygon>(in)); break;
+                default: shapes.emplace_back(); break;
+            }
+        }
+        benchmark::DoNotOptimize(shapes.data());
+    }
+    state.SetBytesProcessed(state.iterations() * snapshot().size());
+}
+
+BENCHMARK(copy_bytes)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(write<some>)->Unit(benchmark::kMillisecond);
+BENCHMARK(write<fsome_sbo>)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(read<some>)->Unit(benchmark::kMillisecond);
+BENCHMARK(read<fsome>)->Unit(benchmark::kMillisecond);
+BENCHMARK(read<fsome_sbo>)->Unit(benchmark::kMillisecond);
+BENCHMARK(read_into_arena)->Unit(benchmark::kMillisecond);
+BENCHMARK(read_hand_written_factory)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,138 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// 10M randomly mixed Circles and Squares (in the SBO) as std::vector<fsome<>> against vx::soa_vector
+/// (the vptrs, the data pointers and the inline slots in separate arrays):
+/// the type scans that read the vptrs only (count the Squares, find the indices of the Circles), the bump() of the Squares
+/// found by their vptr, and the plain calls through every element (the sum of info()) where the layout shouldn't matter.
+///
+/// g++ -std=c++20 -O2 bench_soa_vector.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../soa_vector.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+static constexpr std::size_t N = 10'000'000;
+static constexpr vx::cfg::fsome config {.sbo{8}};
+
+using fsomes = std::vector<vx::fsome<Shape, config>>;
+using soa = vx::soa_vector<Shape, config>;
+
+template <typename Container>
+static Container make_shapes() {
+    Container shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) { shapes.push_back(Circle{}); } else { shapes.push_back(Square{}); }
+    }
+    return shapes;
+}
+
+static void count_fsome(benchmark::State& state) {
+    auto const shapes = make_shapes<fsomes>();
+    auto const square = vx::fsome<Shape, config>{Square{}}.vptr();
+    for (auto _ : state) {
+        auto count = std::count_if(shapes.begin(), shapes.end(), [&](auto const& shape) { return shape.vptr() == square; });
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void count_soa(benchmark::State& state) {
+    auto const shapes = make_shapes<soa>();
+    for (auto _ : state) {
+        auto count = shapes.count<Square>();
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void find_all_fsome(benchmark::State& state) {
+    auto const shapes = make_shapes<fsomes>();
+    auto const circle = vx::fsome<Shape, config>{Circle{}}.vptr();
+    std::vector<std::size_t> found;
+    found.reserve(N);
+    for (auto _ : state) {
+        found.clear();
+        for (std::size_t i = 0; i < N; ++i) {
+            if (shapes[i].vptr() == circle) { found.push_back(i); }
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void find_all_soa(benchmark::State& state) {
+    auto const shapes = make_shapes<soa>();
+    auto const circle = soa::vptr_of<Circle>();
+    std::vector<std::size_t> found;
+    found.reserve(N);
+    for (auto _ : state) {
+        found.clear();
+        auto const vptrs = shapes.vptrs();
+        for (std::size_t i = 0; i < N; ++i) {
+            if (vptrs[i] == circle) { found.push_back(i); }
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void bump_squares_fsome(benchmark::State& state) {
+    auto shapes = make_shapes<fsomes>();
+    auto const square = vx::fsome<Shape, config>{Square{}}.vptr();
+    for (auto _ : state) {
+        for (auto & shape : shapes) {
+            if (shape.vptr() == square) { shape.try_get<Square>()->bump(); }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void bump_squares_soa(benchmark::State& state) {
+    auto shapes = make_shapes<soa>();
+    for (auto _ : state) {
+        shapes.for_each<Square>([](Square & square) { square.bump(); });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void sum_info_fsome(benchmark::State& state) {
+    auto const shapes = make_shapes<fsomes>();
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto const& shape : shapes) { sum += shape->info(); }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void sum_info_soa(benchmark::State& state) {
+    auto const shapes = make_shapes<soa>();
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto shape : shapes) { sum += shape->info(); }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(count_fsome)->Unit(benchmark::kMillisecond);
+BENCHMARK(count_soa)->Unit(benchmark::kMillisecond);
+BENCHMARK(find_all_fsome)->Unit(benchmark::kMillisecond);
+BENCHMARK(find_all_soa)->Unit(benchmark::kMillisecond);
+BENCHMARK(bump_squares_fsome)->Unit(benchmark::kMillisecond);
+BENCHMARK(bump_squares_soa)->Unit(benchmark::kMillisecond);
+BENCHMARK(sum_info_fsome)->Unit(benchmark::kMillisecond);
+BENCHMARK(sum_info_soa)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The shapes loop (quick_bench_some.cpp and quick_bench_fsome.cpp) over the closed set some_of<Shape, Circle, Square>:
+/// through `->` (the vtable of the inline object) and through visit() (a switch, the calls inlined),
+/// against some<> and fsome<> (with and without SBO)
+///
+/// g++ -std=c++20 -O2 bench_some_of.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "../some_of.hpp"
+#include "shapes.hpp"
+
+using namespace bench;
+
+using some = std::vector<vx::some<Shape>>;
+using fsome = std::vector<vx::fsome<Shape>>;
+using fsome_sbo = std::vector<vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>>;
+using some_of = std::vector<vx::some_of<Shape, Circle, Square>>;
+
+static constexpr std::size_t N = 1'000'000;
+
+template <typename Container>
+static Container make_shapes() {
+    Container shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) { shapes.emplace_back(Circle{}); } else { shapes.emplace_back(Square{}); }
+    }
+    return shapes;
+}
+
+template <typename Container>
+static void iterate_and_call(benchmark::State& state) {
+    auto shapes = make_shapes<Container>();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape->info();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+static void iterate_and_call_visit(benchmark::State& state) {
+    auto shapes = make_shapes<some_of>();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape.visit([](auto const& s) { return s.info(); });
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+template <typename Container>
+static void iterate_call_and_bump(benchmark::State& state) {
+    auto shapes = make_shapes<Container>();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape->info();
+            shape->bump();
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+static void iterate_call_and_bump_visit(benchmark::State& state) {
+    auto shapes = make_shapes<some_of>();
+    for (auto _ : state) {
+        std::size_t sides = 0;
+        for (auto && shape : shapes) {
+            sides += shape.visit([](auto & s) { s.bump(); return s.info(); });
+        }
+        benchmark::DoNotOptimize(sides);
+    }
+}
+
+BENCHMARK(iterate_and_call<some>);
+BENCHMARK(iterate_and_call<fsome>);
+BENCHMARK(iterate_and_call<fsome_sbo>);
+BENCHMARK(iterate_and_call<some_of>);
+BENCHMARK(iterate_and_call_visit);
+
+BENCHMARK(iterate_call_and_bump<some>);
+BENCHMARK(iterate_call_and_bump<fsome>);
+BENCHMARK(iterate_call_and_bump<fsome_sbo>);
+BENCHMARK(iterate_call_and_bump<some_of>);
+BENCHMARK(iterate_call_and_bump_visit);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,298 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The core benchmark suite, built against the real some.hpp (the quick_benchmark_examples are squashed copies of it):
+/// iterate-and-call, single call, construct, copy, move, assign and destroy for
+///   some (per SBO size), fsome (per SBO size), poly_view, the classic virtual hierarchy, std::function and std::any,
+/// swept over the object size. Every scenario runs over the same randomly mixed sequence of two types of that size.
+///
+/// Names are <scenario>/<kind>/size:<bytes>, e.g. `--benchmark_filter=iterate_and_call/fsome.*size:16`
+///
+/// cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build --target run_benchmarks   (JSON into build/results)
+/// or: g++ -std=c++20 -O2 bench_suite.cpp -lbenchmark -lpthread && ./a.out --benchmark_out=suite.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <any>
+#include <array>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "shapes.hpp"
+
+using namespace bench;
+
+static constexpr std::size_t N = 1'000;
+
+/// An object of `Size` bytes, the Kind tells the two types apart
+template <std::size_t Size, int Kind>
+struct Blob {
+    static_assert(Size % sizeof(int) == 0);
+    std::array<int, Size / sizeof(int)> data {};
+    explicit Blob(int n) noexcept { data[0] = n; }
+    int info() const noexcept { return data[0] + Kind; }
+    void bump() noexcept { data.back() += 1 - 2 * Kind; }
+};
+
+/// The objects every scenario is built from
+template <std::size_t Size>
+struct objects {
+    using A = Blob<Size, 0>;
+    using B = Blob<Size, 1>;
+
+    objects() {
+        std::mt19937 mt {}; // default initialized for all tests
+        for (std::size_t i = 0; i < N; ++i) {
+            which.push_back(mt() % 2);
+            as.emplace_back(static_cast<int>(i));
+            bs.emplace_back(static_cast<int>(i));
+        }
+    }
+
+    template <typename F>
+    decltype(auto) visit(std::size_t i, F && f) { return which[i] ? f(bs[i]) : f(as[i]); }
+
+    std::vector<bool> which;
+    std::vector<A> as;
+    std::vector<B> bs;
+};
+
+
+/// ===== [ kinds ] =====
+/// holder: the type-erased object, make(obj): a holder of (a copy of/a view to) the obj, call(holder): bump + info
+
+struct classic {
+    struct IBlob : IShape {
+        virtual std::unique_ptr<IBlob> clone() const = 0;
+    };
+
+    template <typename T>
+    struct VBlob final : IBlob {
+        T obj;
+        explicit VBlob(T const& o) : obj{o} {}
+        int info() const noexcept override { return obj.info(); }
+        void bump() noexcept override { obj.bump(); }
+        std::unique_ptr<IBlob> clone() const override { return std::make_unique<VBlob>(*this); }
+    };
+
+    /// value semantics through clone()
+    struct holder {
+        std::unique_ptr<IBlob> p;
+        holder(std::unique_ptr<IBlob> ptr) noexcept : p{std::move(ptr)} {}
+        holder(holder const& other) : p{other.p->clone()} {}
+        holder(holder &&) noexcept = default;
+        holder& operator= (holder const& other) { p = other.p->clone(); return *this; }
+        holder& operator= (holder &&) noexcept = default;
+    };
+
+    static std::string name() { return "classic"; }
+    template <typename T> static holder make(T & obj) { return {std::make_unique<VBlob<T>>(obj)}; }
+    template <typename A, typename B> static int call(holder & h) { h.p->bump(); return h.p->info(); }
+};
+
+template <vx::u16 SBO>
+struct some_kind {
+    using holder = vx::some<Shape, vx::cfg::some{.sbo{SBO}}>;
+    static std::string name() { return "some<sbo=" + std::to_string(SBO) + ">"; }
+    template <typename T> static holder make(T & obj) { return holder{obj}; }
+    template <typename A, typename B> static int call(holder & h) { h->bump(); return h->info(); }
+};
+
+template <vx::u16 SBO>
+struct fsome_kind {
+    using holder = vx::fsome<Shape, vx::cfg::fsome{.sbo{SBO}}>;
+    static std::string name() { return "fsome<sbo=" + std::to_string(SBO) + ">"; }
+    template <typename T> static holder make(T & obj) { return holder{obj}; }
+    template <typename A, typename B> static int call(holder & h) { h->bump(); return h->info(); }
+};
+
+/// non-owning: views the objects kept by the `objects`
+struct view_kind {
+    using holder = vx::some<Shape&>;
+    static std::string name() { return "poly_view"; }
+    template <typename T> static holder make(T & obj) { return holder{obj}; }
+    template <typename A, typename B> static int call(holder & h) { h->bump(); return h->info(); }
+};
+
+struct function_kind {
+    using holder = std::function<int()>;
+    static std::string name() { return "std::function"; }
+    template <typename T> static holder make(T & obj) { return [obj]() mutable { obj.bump(); return obj.info(); }; }
+    template <typename A, typename B> static int call(holder & h) { return h(); }
+};
+
+/// no dispatch of its own: any_cast to each of the types in turn
+struct any_kind {
+    using holder = std::any;
+    static std::string name() { return "std::any"; }
+    template <typename T> static holder make(T & obj) { return holder{obj}; }
+    template <typename A, typename B> static int call(holder & h) {
+        if (auto * a = std::any_cast<A>(&h)) { a->bump(); return a->info(); }
+        auto * b = std::any_cast<B>(&h);
+        b->bump();
+        return b->info();
+    }
+};
+
+
+/// ===== [ scenarios ] =====
+
+template <typename Kind, std::size_t Size>
+static std::vector<typename Kind::holder> make_all(objects<Size> & objs) {
+    std::vector<typename Kind::holder> holders;
+    holders.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        objs.visit(i, [&](auto & obj) { holders.push_back(Kind::make(obj)); });
+    }
+    return holders;
+}
+
+template <typename Kind, std::size_t Size>
+static void iterate_and_call(benchmark::State& state) {
+    objects<Size> objs;
+    auto holders = make_all<Kind>(objs);
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto & h : holders) { sum += Kind::template call<typename objects<Size>::A, typename objects<Size>::B>(h); }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Kind, std::size_t Size>
+static void single_call(benchmark::State& state) {
+    objects<Size> objs;
+    auto holders = make_all<Kind>(objs);
+    auto & h = holders[N / 2];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Kind::template call<typename objects<Size>::A, typename objects<Size>::B>(h));
+    }
+}
+
+/// N constructions from the objects, into reserved memory (the destruction is not timed)
+template <typename Kind, std::size_t Size>
+static void construct(benchmark::State& state) {
+    objects<Size> objs;
+    std::vector<typename Kind::holder> holders;
+    holders.reserve(N);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < N; ++i) {
+            objs.visit(i, [&](auto & obj) { holders.push_back(Kind::make(obj)); });
+        }
+        benchmark::DoNotOptimize(holders.data());
+        state.PauseTiming();
+        holders.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Kind, std::size_t Size>
+static void copy(benchmark::State& state) {
+    objects<Size> objs;
+    auto const source = make_all<Kind>(objs);
+    std::vector<typename Kind::holder> copies;
+    copies.reserve(N);
+    for (auto _ : state) {
+        for (auto const& h : source) { copies.push_back(h); }
+        benchmark::DoNotOptimize(copies.data());
+        state.PauseTiming();
+        copies.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Kind, std::size_t Size>
+static void move(benchmark::State& state) {
+    objects<Size> objs;
+    std::vector<typename Kind::holder> moved;
+    moved.reserve(N);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto source = make_all<Kind>(objs);
+        moved.clear();
+        state.ResumeTiming();
+        for (auto & h : source) { moved.push_back(std::move(h)); }
+        benchmark::DoNotOptimize(moved.data());
+        state.PauseTiming(); // the source is destroyed here
+        source.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+/// copy-assignment over the objects of the other type, in the same order
+template <typename Kind, std::size_t Size>
+static void assign(benchmark::State& state) {
+    objects<Size> objs;
+    auto const source = make_all<Kind>(objs);
+    auto targets = make_all<Kind>(objs);
+    std::rotate(targets.begin(), targets.begin() + 1, targets.end());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < N; ++i) { targets[i] = source[i]; }
+        benchmark::DoNotOptimize(targets.data());
+        state.PauseTiming();
+        std::rotate(targets.begin(), targets.begin() + 1, targets.end());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Kind, std::size_t Size>
+static void destroy(benchmark::State& state) {
+    objects<Size> objs;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto holders = make_all<Kind>(objs);
+        state.ResumeTiming();
+        holders.clear();
+        benchmark::DoNotOptimize(holders.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+
+/// ===== [ registration ] =====
+
+template <typename Kind, std::size_t Size>
+static void register_kind() {
+    auto name = [](char const* scenario) { return std::string{scenario} + "/" + Kind::name() + "/size:" + std::to_string(Size); };
+    benchmark::RegisterBenchmark(name("iterate_and_call").c_str(), iterate_and_call<Kind, Size>);
+    benchmark::RegisterBenchmark(name("single_call").c_str(), single_call<Kind, Size>);
+    benchmark::RegisterBenchmark(name("construct").c_str(), construct<Kind, Size>);
+    benchmark::RegisterBenchmark(name("copy").c_str(), copy<Kind, Size>);
+    benchmark::RegisterBenchmark(name("move").c_str(), move<Kind, Size>);
+    benchmark::RegisterBenchmark(name("assign").c_str(), assign<Kind, Size>);
+    benchmark::RegisterBenchmark(name("destroy").c_str(), destroy<Kind, Size>);
+}
+
+/// the object sizes, every kind is run with each of them
+template <typename Kind>
+static void register_sizes() {
+    register_kind<Kind, 8>();
+    register_kind<Kind, 16>();
+    register_kind<Kind, 32>();
+    register_kind<Kind, 64>();
+    register_kind<Kind, 128>();
+}
+
+int main(int argc, char** argv) {
+    register_sizes<classic>();
+    register_sizes<some_kind<0>>();
+    register_sizes<some_kind<24>>(); // the default
+    register_sizes<some_kind<64>>();
+    register_sizes<fsome_kind<0>>(); // the default
+    register_sizes<fsome_kind<16>>();
+    register_sizes<fsome_kind<64>>();
+    register_sizes<view_kind>();
+    register_sizes<function_kind>();
+    register_sizes<any_kind>();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
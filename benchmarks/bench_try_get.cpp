@@ -0,0 +1,83 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// try_get over randomly mixed Circles and Squares: the type token / vptr compare vs. the dynamic_cast it replaced
+///
+/// g++ -std=c++20 -O2 bench_try_get.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "shapes.hpp"
+
+using namespace bench;
+
+static constexpr std::size_t N = 100'000;
+
+template <typename Some>
+static std::vector<Some> make_shapes() {
+    std::vector<Some> shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 2 == 0) {
+            shapes.emplace_back(Circle{});
+        } else {
+            shapes.emplace_back(Square{});
+        }
+    }
+    return shapes;
+}
+
+template <typename Some>
+static void try_get_dynamic_cast(benchmark::State& state) {
+    using Impl = typename Some::template impl_type<Circle>;
+    auto shapes = make_shapes<Some>();
+    for (auto _ : state) {
+        std::size_t circles = 0;
+        for (auto const& shape : shapes) {
+            circles += dynamic_cast<Impl const*>(&*shape) != nullptr;
+        }
+        benchmark::DoNotOptimize(circles);
+    }
+}
+
+template <typename Some>
+static void try_get(benchmark::State& state) {
+    auto shapes = make_shapes<Some>();
+    for (auto _ : state) {
+        std::size_t circles = 0;
+        for (auto const& shape : shapes) {
+            circles += shape.template try_get<Circle>() != nullptr;
+        }
+        benchmark::DoNotOptimize(circles);
+    }
+}
+
+/// the Addable::add pattern of examples/some_multidispatch_example.cpp: both sides have to be of the same type
+template <typename Some>
+static void some_cast_pairs(benchmark::State& state) {
+    auto shapes = make_shapes<Some>();
+    for (auto _ : state) {
+        int sum = 0;
+        for (std::size_t i = 1; i < shapes.size(); ++i) {
+            if (auto * a = vx::some_cast<Circle>(&shapes[i-1])) {
+                if (auto * b = vx::some_cast<Circle>(&shapes[i])) { sum += a->info() + b->info(); }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+using some = vx::some<Shape>;
+using fsome = vx::fsome<Shape>;
+
+BENCHMARK(try_get_dynamic_cast<some>);
+BENCHMARK(try_get<some>);
+BENCHMARK(try_get_dynamic_cast<fsome>);
+BENCHMARK(try_get<fsome>);
+BENCHMARK(some_cast_pairs<some>);
+BENCHMARK(some_cast_pairs<fsome>);
+
+BENCHMARK_MAIN();
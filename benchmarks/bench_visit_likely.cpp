@@ -0,0 +1,83 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Speculative devirtualization: 90% of the shapes are Circles, the rest are Squares (randomly mixed).
+/// A plain virtual call vs. visit_likely<Circle> and visit_likely<Circle, Square> (the calls inlined on a hit),
+/// and the cost of the likely_counter on top of it
+///
+/// g++ -std=c++20 -O2 bench_visit_likely.cpp -lbenchmark -lpthread
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "shapes.hpp"
+
+using namespace bench;
+
+using some = vx::some<Shape>;
+using fsome = vx::fsome<Shape>;
+
+static constexpr std::size_t N = 100'000;
+
+template <typename Some>
+static std::vector<Some> make_shapes() {
+    std::vector<Some> shapes;
+    shapes.reserve(N);
+    std::mt19937 mt {}; // default initialized for all tests
+    for (std::size_t i = 0; i < N; ++i) {
+        if (mt() % 10 != 0) { shapes.emplace_back(Circle{}); } else { shapes.emplace_back(Square{}); }
+    }
+    return shapes;
+}
+
+template <typename Some>
+static void virtual_call(benchmark::State& state) {
+    auto shapes = make_shapes<Some>();
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto & shape : shapes) {
+            shape->bump();
+            sum += shape->info();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template <typename Some, typename... Likely>
+static void likely_call(benchmark::State& state) {
+    auto shapes = make_shapes<Some>();
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto & shape : shapes) {
+            sum += vx::visit_likely<Likely...>(shape, [](auto & s) { s.bump(); return s.info(); });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template <typename Some, typename... Likely>
+static void likely_call_counted(benchmark::State& state) {
+    auto shapes = make_shapes<Some>();
+    vx::likely_counter counter;
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto & shape : shapes) {
+            sum += vx::visit_likely<Likely...>(shape, [](auto & s) { s.bump(); return s.info(); }, &counter);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["hit_rate"] = counter.hit_rate();
+}
+
+BENCHMARK(virtual_call<fsome>);
+BENCHMARK(likely_call<fsome, Circle>);
+BENCHMARK(likely_call<fsome, Circle, Square>);
+BENCHMARK(likely_call_counted<fsome, Circle>);
+
+BENCHMARK(virtual_call<some>);
+BENCHMARK(likely_call<some, Circle>);
+BENCHMARK(likely_call<some, Circle, Square>);
+BENCHMARK(likely_call_counted<some, Circle>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// Hardware performance counters for the benchmarks, through Linux perf_event_open:
+/// cycles, instructions, L1d and LLC read misses, branch mispredictions and dTLB read misses of the calling thread.
+///
+/// Every counter is opened on its own (not as a group), so that the ones the CPU/VM/kernel doesn't provide
+/// are simply left out, and the kernel multiplexes the rest if they don't all fit; the values are scaled back up.
+/// When none can be opened (not Linux, perf_event_paranoid, a container without perf, ...) the counters are
+/// `available() == false`, `why_unavailable()` says why and the benchmarks report the wall-clock time only.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+class perf_counters {
+public:
+    enum event : unsigned { cycles, instructions, l1d_misses, llc_misses, branch_misses, dtlb_misses, n_events };
+
+    static constexpr std::array<char const*, n_events> names {
+        "cycles", "instructions", "L1d_misses", "LLC_misses", "branch_misses", "dTLB_misses"
+    };
+
+    perf_counters() { open_all(); }
+    ~perf_counters() { close_all(); }
+    perf_counters(perf_counters const&) = delete;
+    perf_counters& operator= (perf_counters const&) = delete;
+
+    bool available() const noexcept { return n_open_ > 0; }
+    bool available(event e) const noexcept { return fds_[e] >= 0; }
+    std::string const& why_unavailable() const noexcept { return why_; }
+
+    /// resets and enables all the open counters
+    void start() noexcept {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd < 0) { continue; }
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// disables the counters and reads them, a counter that is not available reads as 0
+    std::array<double, n_events> stop() noexcept {
+        std::array<double, n_events> values {};
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd >= 0) { ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); }
+        }
+        for (unsigned e = 0; e < n_events; ++e) {
+            if (fds_[e] < 0) { continue; }
+            std::uint64_t data[3] {}; // value, time enabled, time running
+            if (read(fds_[e], data, sizeof data) != sizeof data || data[2] == 0) { continue; }
+            // scaled up if the counter was multiplexed with the others
+            values[e] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        }
+#endif
+        return values;
+    }
+
+private:
+#if defined(__linux__)
+    static constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t op, std::uint64_t result) noexcept {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    void open_all() {
+        struct config_t { std::uint32_t type; std::uint64_t config; };
+        constexpr std::array<config_t, n_events> configs {{
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+            {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        }};
+
+        for (unsigned e = 0; e < n_events; ++e) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof attr);
+            attr.size = sizeof attr;
+            attr.type = configs[e].type;
+            attr.config = configs[e].config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1; // allowed with perf_event_paranoid <= 2
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            // this thread, any cpu
+            fds_[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds_[e] >= 0) {
+                ++n_open_;
+            } else if (why_.empty()) {
+                why_ = std::string{"perf_event_open("} + names[e] + "): " + std::strerror(errno);
+            }
+        }
+        if (n_open_ == 0 && why_.empty()) { why_ = "no counters"; }
+    }
+
+    void close_all() noexcept {
+        for (int & fd : fds_) {
+            if (fd >= 0) { close(fd); }
+            fd = -1;
+        }
+    }
+#else
+    void open_all() { why_ = "perf_event_open is Linux only"; }
+    void close_all() noexcept {}
+#endif
+
+    std::array<int, n_events> fds_ { -1, -1, -1, -1, -1, -1 };
+    unsigned n_open_ = 0;
+    std::string why_;
+};
+
+} // namespace bench
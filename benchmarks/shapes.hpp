@@ -0,0 +1,71 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The shapes used throughout the benchmarks: 
+/// a `Shape` trait with its `Square` and `Circle` and the classic virtual `IShape` hierarchy to compare against
+#pragma once
+
+#include <array>
+
+#include "../some.hpp"
+
+namespace bench {
+
+/// Classic dynamic polymorphism
+struct IShape {
+    virtual ~IShape() = default;
+    virtual int info() const noexcept = 0;
+    virtual void bump() noexcept = 0;
+};
+
+struct VSquare final : public IShape {
+    int side_ = 0;
+    VSquare() = default;
+    explicit VSquare(int side) : side_{side} {}
+    int info() const noexcept override { return side_; }
+    void bump() noexcept override { side_ += 1; }
+};
+
+struct VCircle final : public IShape {
+    int radius_ = 0;
+    VCircle() = default;
+    explicit VCircle(int radius) : radius_{radius} {}
+    int info() const noexcept override { return radius_; }
+    void bump() noexcept override { radius_ -= 1; }
+};
+
+/// The vx way
+struct Shape : vx::trait {
+    virtual int info() const noexcept = 0;
+    virtual void bump() noexcept = 0;
+};
+
+struct Square { // no inheritance
+    int side_ = 0;
+    int info() const noexcept { return side_; }
+    void bump() noexcept { side_ += 1; }
+};
+
+struct Circle {
+    int radius_ = 0;
+    int info() const noexcept { return radius_; }
+    void bump() noexcept { radius_ -= 1; }
+};
+
+/// Too big for the default SBO of some<> (24 bytes), so it ends up on the heap
+struct Polygon {
+    int sides_ = 0;
+    std::array<float, 8> vertices_ {};
+    int info() const noexcept { return sides_; }
+    void bump() noexcept { sides_ += 1; }
+};
+
+} // namespace bench
+
+template <typename T>
+struct vx::impl<bench::Shape, T> final : impl_for<bench::Shape, T> {
+    using impl_for<bench::Shape, T>::impl_for; // pull in the ctors
+    using impl_for<bench::Shape, T>::self;
+    int info() const noexcept override { return self().info(); }
+    void bump() noexcept override { self().bump(); }
+};
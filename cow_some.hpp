@@ -0,0 +1,77 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <cstddef> // size_t
+#include <type_traits>
+#include <utility> // forward, move
+
+#include "shared_some.hpp"
+
+namespace vx {
+
+/// ===== [ COW SOME ] =====
+///@brief: A copy-on-write polymorphic object with value semantics: copies share the object (a reference count bump,
+/// see shared_some) and the object is only cloned on the first non-const access of a copy that isn't the only one.
+/// The const/non-const split is the one of basic_operations_for: the const `->`, `*` and try_get read the shared object,
+/// the non-const ones make it unique first. Good for the snapshots and histories of a state that's rarely changed.
+///@note: a non-const access to a shared object clones it with `do_action(share_copy_into)`, so the T has to be copyable
+///@note: the copies can be used from different threads, but a single cow_some is not to be accessed concurrently
+template <typename Trait>
+class cow_some : public basic_operations_for<cow_some<Trait>, Trait> {
+    using main_trait_t = first_trait_from<Trait>;
+
+public:
+    template <typename X>
+    using impl_type = vx::impl< Trait, std::remove_cvref_t<X> >;
+
+    cow_some() noexcept = default;
+
+    template <typename T>
+    requires (not polymorphic<T> && not std::is_same_v<std::remove_cvref_t<T>, cow_some>)
+    cow_some(T && obj) : shared_{std::forward<T>(obj)} {
+        static_assert(std::is_copy_constructible_v<std::remove_cvref_t<T>>, "cow_some requires a copyable object");
+    }
+
+    /// takes over the object of the `other` (moved into a new shared block), leaving the `other` empty
+    template <cfg::some config>
+    requires (config.copy)
+    explicit cow_some(some<Trait, config> && other) : shared_{std::move(other)} {}
+
+    cow_some(cow_some const&) noexcept = default;
+    cow_some(cow_some &&) noexcept = default;
+    cow_some& operator= (cow_some const&) noexcept = default;
+    cow_some& operator= (cow_some &&) noexcept = default;
+
+    /// the number of cow_somes sharing the object
+    std::size_t use_count() const noexcept { return shared_.use_count(); }
+
+    /// clones the object, unless it's not shared
+    void detach() {
+        if (not shared_.header_ || shared_.header_->strong.load(std::memory_order_acquire) == 1) { return; }
+        auto * original = const_cast<main_trait_t *>(shared_.object_);
+        shared_some<Trait> copy;
+        copy.object_ = static_cast<main_trait_t const*>(
+            original->do_action(detail::opcode::share_copy_into, nullptr, {}, &copy.header_, nullptr));
+        shared_.swap(copy);
+    }
+
+    explicit operator bool() const noexcept { return static_cast<bool>(shared_); }
+
+protected:
+    friend struct basic_operations_for<cow_some<Trait>, Trait>;
+
+    main_trait_t const* trait_ptr() const noexcept { return shared_.object_; }
+
+    /// the object is ours alone from here on
+    main_trait_t * trait_ptr() {
+        detach();
+        return const_cast<main_trait_t *>(shared_.object_);
+    }
+
+private:
+    shared_some<Trait> shared_;
+};
+
+} // namespace vx
@@ -0,0 +1,38 @@
+#include <cassert>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+#include "shapes.hpp"
+#include "../some.hpp"
+
+using namespace shapes;
+
+/// The "Memory resources" and "Arenas" snippets of the README, as they are written there
+struct Request {
+    struct Item { float radius; };
+    std::vector<Item> shapes;
+};
+
+float handle(Request const& request) {
+    vx::arena scope {}; // or vx::arena scope {buffer, sizeof(buffer)} to start off with a buffer on the stack
+    std::vector<vx::some<Shape, {.sbo{0}, .pmr=true}>> shapes;
+    for (auto && s : request.shapes) { shapes.emplace_back(Circle{s.radius}); }
+    assert(( shapes.empty() || shapes.front().get_allocator().resource() == &scope ));
+
+    float total = 0;
+    for (auto const& shape : shapes) { total += shape->area(); }
+    return total;
+} // the shapes and then the arena memory are released here
+
+int main() {
+    std::pmr::monotonic_buffer_resource arena {};
+    std::pmr::vector<vx::some<Shape, {.pmr=true}>> shapes(&arena); // not braces: those would take the &arena for an element
+    shapes.emplace_back(Circle{}); // both the vector buffer and the Circle live in the arena
+
+    vx::fsome<Shape, {.pmr=true}> f {std::allocator_arg, &arena, Square{}};
+
+    assert(( shapes.size() == 1 && shapes.front().get_allocator().resource() == &arena ));
+    assert(( f.get_allocator().resource() == &arena ));
+
+    std::cout << "total area: " << handle(Request{{{1}, {2}}}) << "\n";
+}
@@ -0,0 +1,86 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+/// The shapes of the README, with a batch hook: a vectorized area of a run of Circles or Squares at once
+/// (used by poly_collection::transform), while the Triangles make do with the scalar virtual area()
+#pragma once
+
+#include <cstddef> // size_t
+#include <numbers> // pi_v
+#include <ostream>
+#include <span>
+
+#include "../poly_collection.hpp"
+
+namespace shapes {
+
+struct Shape : vx::trait {
+    virtual void draw(std::ostream&) const = 0;
+    virtual float area() const = 0;
+};
+
+/// 8 floats at a time, a block that fits a 256-bit register (two 128-bit ones): the loads and the math
+/// of a block are straight-line code the compiler turns into vector instructions, the tail is done one by one
+template <typename T, typename Kernel>
+inline void for_each_block(std::span<const T> items, std::span<float> out, Kernel kernel) noexcept {
+    constexpr std::size_t lanes = 8;
+    std::size_t i = 0;
+    for (; i + lanes <= items.size(); i += lanes) {
+        float block[lanes];
+        for (std::size_t k = 0; k < lanes; ++k) { block[k] = kernel(items[i + k]); }
+        for (std::size_t k = 0; k < lanes; ++k) { out[i + k] = block[k]; }
+    }
+    for (; i < items.size(); ++i) { out[i] = kernel(items[i]); }
+}
+
+struct Circle {
+    float radius = 0;
+    void draw(std::ostream& out) const { out << "Circle(" << radius << ")"; }
+    float area() const noexcept { return std::numbers::pi_v<float> * radius * radius; }
+
+    static void area_batch(std::span<const Circle> circles, std::span<float> out) noexcept {
+        for_each_block(circles, out, [](Circle const& c) { return std::numbers::pi_v<float> * c.radius * c.radius; });
+    }
+};
+
+struct Square {
+    float side = 0;
+    void draw(std::ostream& out) const { out << "Square(" << side << ")"; }
+    float area() const noexcept { return side * side; }
+
+    static void area_batch(std::span<const Square> squares, std::span<float> out) noexcept {
+        for_each_block(squares, out, [](Square const& s) { return s.side * s.side; });
+    }
+};
+
+/// no batch form
+struct Triangle {
+    float base = 0, height = 0;
+    void draw(std::ostream& out) const { out << "Triangle(" << base << ", " << height << ")"; }
+    float area() const noexcept { return base * height / 2; }
+};
+
+/// the area of the shapes for poly_collection::transform:
+/// the batch hook of the impl<Shape, T> for a segment of Ts where there's one, the virtual area() per shape otherwise
+struct area {
+    float operator()(Shape const& shape) const { return shape.area(); }
+
+    template <typename T>
+    requires requires (std::span<const T> items, std::span<float> out) { vx::impl<Shape, T>::area_batch(items, out); }
+    void operator()(std::span<const T> items, std::span<float> out) const { vx::impl<Shape, T>::area_batch(items, out); }
+};
+
+} // namespace shapes
+
+template <typename T>
+struct vx::impl<shapes::Shape, T> final : vx::impl_for<shapes::Shape, T> {
+    using vx::impl_for<shapes::Shape, T>::impl_for;
+    using vx::impl_for<shapes::Shape, T>::self;
+    void draw(std::ostream& out) const override { self().draw(out); }
+    float area() const override { return self().area(); }
+
+    /// the batch hook: the areas of a run of Ts at once, for the Ts that have a batch kernel
+    template <typename U = T>
+    requires requires (std::span<const U> items, std::span<float> out) { U::area_batch(items, out); }
+    static void area_batch(std::span<const U> items, std::span<float> out) noexcept { U::area_batch(items, out); }
+};
@@ -0,0 +1,36 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "shapes.hpp"
+
+using namespace shapes;
+
+int main() {
+    vx::poly_collection<Shape> collection;
+    for (int i = 0; i < 100; ++i) {
+        collection.insert(Circle{float(i) / 10});
+        collection.insert(Square{float(i)});
+        if (i % 10 == 0) { collection.insert(Triangle{float(i), 2}); }
+    }
+
+    // Circles and Squares: one call to the vectorized area_batch per segment, Triangles: the virtual area() per shape
+    std::vector<float> areas(collection.size());
+    collection.transform<Circle, Square, Triangle>(std::span{areas}, area{});
+
+    // the same as the scalar virtual calls, in the same order
+    std::size_t i = 0;
+    for (vx::some<Shape const&> shape : std::as_const(collection)) {
+        assert(( std::abs(areas[i++] - shape->area()) <= 1e-3f * (1 + shape->area()) ));
+    }
+    assert(( i == areas.size() ));
+
+    // the types not listed go through the virtual area() per shape
+    std::vector<float> virtual_areas(collection.size());
+    collection.transform(std::span{virtual_areas}, area{});
+    for (std::size_t k = 0; k < areas.size(); ++k) { assert(( std::abs(areas[k] - virtual_areas[k]) <= 1e-3f * (1 + areas[k]) )); }
+
+    float total = 0;
+    for (float a : areas) { total += a; }
+    std::cout << "total area: " << total << "\n";
+}
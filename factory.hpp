@@ -0,0 +1,202 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // copy_n, sort
+#include <array>
+#include <bit> // bit_ceil
+#include <concepts>
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <span>
+#include <stdexcept> // runtime_error
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility> // forward
+
+#include "some.hpp"
+
+namespace vx {
+
+struct factory_error : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+/// a string literal as a template argument
+template <std::size_t N>
+struct fixed_string {
+    char chars[N] {};
+
+    constexpr fixed_string() noexcept = default;
+    constexpr fixed_string(const char (&literal)[N]) noexcept { std::copy_n(literal, N, chars); }
+
+    constexpr std::string_view view() const noexcept { return {chars, N - 1}; }
+};
+
+/// a factory entry: the T is made under the Name
+template <fixed_string Name, typename T>
+struct named {
+    static constexpr std::string_view name = Name.view();
+    using type = T;
+};
+
+
+namespace detail {
+    /// FNV-1a: one pass over the name, the rest of the perfect hash is mixed out of it
+    constexpr std::uint64_t name_hash(std::string_view name) noexcept {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : name) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    /// splitmix64 of the name's hash and the seed
+    constexpr std::uint64_t rehash(std::uint64_t h, std::uint32_t seed) noexcept {
+        h ^= seed * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 27; h *= 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+
+    /// hash and displace: the names go into the buckets by their hash, then each bucket (the bigger ones first)
+    /// gets a seed that rehashes all of its names into the free slots of the table.
+    /// A lookup is a hash of the name, two loads and a compare of the name found in the slot.
+    template <std::size_t N>
+    struct perfect_hash {
+        static constexpr std::size_t n_buckets = std::bit_ceil(N);
+        static constexpr std::size_t n_slots = 2 * n_buckets; ///< no more than half full, the seeds are found fast
+
+        std::array<std::uint32_t, n_buckets> seeds {};
+        std::array<std::uint32_t, n_slots> slots {}; ///< the index of the name, N for a free slot
+
+        /// the index of the only name that can be `name`, N if there's none
+        constexpr std::size_t candidate(std::string_view name) const noexcept {
+            auto const h = name_hash(name);
+            return slots[rehash(h, seeds[h & (n_buckets - 1)]) & (n_slots - 1)];
+        }
+    };
+
+    template <std::size_t N>
+    consteval perfect_hash<N> make_perfect_hash(std::array<std::string_view, N> const& names) {
+        using ph = perfect_hash<N>;
+        perfect_hash<N> result;
+        result.slots.fill(N);
+
+        std::array<std::uint64_t, N> hashes {};
+        std::array<std::size_t, ph::n_buckets + 1> first {}; // the names by bucket: order[first[b], first[b + 1])
+        std::array<std::size_t, N> order {};
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] = name_hash(names[i]);
+            ++first[(hashes[i] & (ph::n_buckets - 1)) + 1];
+        }
+        for (std::size_t b = 0; b < ph::n_buckets; ++b) { first[b + 1] += first[b]; }
+        auto next = first;
+        for (std::size_t i = 0; i < N; ++i) { order[next[hashes[i] & (ph::n_buckets - 1)]++] = i; }
+
+        std::array<std::size_t, ph::n_buckets> buckets {};
+        for (std::size_t b = 0; b < ph::n_buckets; ++b) { buckets[b] = b; }
+        std::sort(buckets.begin(), buckets.end(), [&](std::size_t a, std::size_t b) {
+            return first[a + 1] - first[a] > first[b + 1] - first[b];
+        });
+
+        for (std::size_t b : buckets) {
+            auto const begin = first[b], end = first[b + 1];
+            if (begin == end) { break; }
+            for (std::uint32_t seed = 0;; ++seed) {
+                if (seed == (1u << 20)) { throw "vx::factory: no perfect hash found, the hashes of two names collide"; }
+                bool fits = true;
+                for (std::size_t k = begin; k < end && fits; ++k) {
+                    auto const slot = rehash(hashes[order[k]], seed) & (ph::n_slots - 1);
+                    fits = result.slots[slot] == N;
+                    for (std::size_t j = begin; j < k && fits; ++j) {
+                        fits = slot != (rehash(hashes[order[j]], seed) & (ph::n_slots - 1));
+                    }
+                }
+                if (not fits) { continue; }
+                for (std::size_t k = begin; k < end; ++k) {
+                    result.slots[rehash(hashes[order[k]], seed) & (ph::n_slots - 1)] = static_cast<std::uint32_t>(order[k]);
+                }
+                result.seeds[b] = seed;
+                break;
+            }
+        }
+        return result;
+    }
+
+    template <std::size_t N>
+    consteval bool distinct(std::array<std::string_view, N> names) {
+        std::sort(names.begin(), names.end());
+        return std::adjacent_find(names.begin(), names.end()) == names.end();
+    }
+}// namespace detail
+
+
+/// ===== [ FACTORY ] =====
+///@brief: Makes the objects of the types registered under the names, the names are known at compile time:
+///     using handlers = vx::factory<Handler, vx::named<"echo", Echo>, vx::named<"log", Logger>>;
+///     vx::some<Handler> h = handlers::make("log", config);       // or handlers::make<vx::fsome<Handler>>(...)
+///     handlers::make_into(objects[i], name, config);              // into an existing some<> / fsome<>
+/// - the name is looked up with a perfect hash generated at compile time (see detail::perfect_hash)
+/// - the T is constructed in place out of the arguments (emplace), right in the SBO or the heap placement of the object
+/// - any holder of the Trait will do (the configs of some<> and fsome<>), the make_into() for each is instantiated on use
+///@note: the types that can't be constructed out of the given arguments throw when asked for under their name
+template <typename Trait, typename... Entries>
+class factory {
+    static constexpr std::size_t N = sizeof...(Entries);
+    static_assert(N > 0, "vx::factory: no entries");
+
+    static constexpr std::array<std::string_view, N> names_ {Entries::name...};
+    static_assert(detail::distinct(names_), "vx::factory: the names are expected to be unique");
+
+    static constexpr auto hash_ = detail::make_perfect_hash(names_);
+
+    template <typename Object, typename... Args>
+    using make_fn = void (*)(Object &, Args&&...);
+
+    template <typename T, typename Object, typename... Args>
+    static void make_as(Object & target, Args&&... args) {
+        if constexpr (std::is_constructible_v<T, Args&&...>) {
+            target.template emplace<T>(std::forward<Args>(args)...);
+        } else {
+            throw factory_error{"vx::factory: the type can't be made out of the arguments"};
+        }
+    }
+
+public:
+    static constexpr std::size_t size() noexcept { return N; }
+
+    static constexpr std::span<const std::string_view> names() noexcept { return names_; }
+
+    /// the position of the name in the Entries..., size() if it's not there
+    static constexpr std::size_t index_of(std::string_view name) noexcept {
+        auto const i = hash_.candidate(name);
+        return (i < N && names_[i] == name) ? i : N;
+    }
+
+    static constexpr bool contains(std::string_view name) noexcept { return index_of(name) != N; }
+
+    ///@brief: replaces the object of the `target` (some<Trait> / fsome<Trait>) with the one made under the name
+    ///@throws factory_error: the name isn't there, or its type can't be made out of the args
+    template <typename Object, typename... Args>
+    static void make_into(Object & target, std::string_view name, Args&&... args) {
+        static_assert(requires (Object & object) { { object.operator->() } -> std::convertible_to<Trait const*>; },
+                      "vx::factory<Trait>: the objects are made into the holders of the Trait");
+        static constexpr make_fn<Object, Args...> makers[] = { &make_as<typename Entries::type, Object, Args...>... };
+        auto const i = index_of(name);
+        if (i == N) { throw factory_error{"vx::factory: unknown name '" + std::string{name} + "'"}; }
+        makers[i](target, std::forward<Args>(args)...);
+    }
+
+    template <typename Object = some<Trait>, typename... Args>
+    static Object make(std::string_view name, Args&&... args) {
+        Object object;
+        make_into(object, name, std::forward<Args>(args)...);
+        return object;
+    }
+};
+
+} // namespace vx
@@ -0,0 +1,164 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <bit> // bit_cast
+#include <cstddef> // byte, size_t
+#include <cstring> // memcpy
+#include <memory> // construct_at, destroy_at
+#include <new> // launder
+#include <type_traits>
+#include <utility> // forward, move
+
+#include "some.hpp"
+
+namespace vx {
+
+template <typename Trait, cfg::fsome config = cfg::fsome{}>
+class flat_some;
+
+namespace detail {
+    template <typename Trait, cfg::fsome config>
+    struct is_polymorphic< flat_some<Trait, config> > : std::true_type {};
+
+    /// the vptrs of impl<Traits, T*>... for one T, in the order of the mix
+    template <std::size_t n_traits>
+    struct flat_table {
+        const void* vptrs[n_traits];
+    };
+
+    /// the vptr of an impl<Trait, T*>, read off a temporary one (the T* isn't dereferenced)
+    template <typename Trait, typename T>
+    const void* view_vptr_of() noexcept {
+        using view_t = vx::impl<Trait, T*>;
+        static_assert(sizeof(view_t) == sizeof(Trait) + sizeof(void*), "impl<Trait, T*> is expected to hold a T* and nothing else");
+        alignas(view_t) std::byte buffer[sizeof(view_t)];
+        auto * view = std::construct_at(reinterpret_cast<view_t*>(buffer), static_cast<T*>(nullptr));
+        const void* vptr;
+        std::memcpy(&vptr, buffer, sizeof(vptr));
+        std::destroy_at(view);
+        return vptr;
+    }
+
+    template <typename T, typename... Traits>
+    flat_table<sizeof...(Traits)> const& flat_table_for() noexcept {
+        static const flat_table<sizeof...(Traits)> table { {view_vptr_of<Traits, T>()...} };
+        return table;
+    }
+}// namespace detail
+
+
+/// ===== [ FLAT VIEW ] =====
+///@brief: One trait of a flat_some: an impl<Trait, T*> put together from the vptr in the table and the data pointer,
+/// the way some_ptr keeps it. Pointer-like, valid for as long as the flat_some isn't modified or moved.
+///@note: Trait can be const-qualified
+template <typename Trait>
+class flat_view {
+    using raw_trait_t = std::remove_cv_t<Trait>;
+    using layout = struct { const void* vptr; void* dptr; };
+
+    static constexpr auto k_trait_size = sizeof(raw_trait_t) + sizeof(void*);
+
+public:
+    flat_view(const void* vptr, void* dptr) noexcept {
+        layout bits {vptr, dptr};
+        std::memcpy(&iface, &bits, k_trait_size);
+    }
+
+    Trait* operator-> () const noexcept { return get(); }
+    Trait& operator* () const noexcept { return *get(); }
+
+    /// same as some_ptr, the iface is accessed through the Trait* (see some_ptr::trait_ptr)
+    Trait* get() const noexcept {
+        return std::launder(reinterpret_cast<Trait*>(const_cast<std::byte*>(iface)));
+    }
+
+    explicit operator bool() const noexcept { return std::bit_cast<layout>(iface).vptr != nullptr; }
+
+private:
+    alignas(raw_trait_t) std::byte iface[k_trait_size];
+};
+
+
+/// ===== [ FLAT SOME ] =====
+///@brief: An fsome for the mixed traits with a single vptr inline, however many traits there are:
+/// some<mix<A, B, C>> holds an impl<mix<A, B, C>, T> which derives from all the traits and so has a vptr per trait,
+/// a flat_some<mix<A, B, C>> is an fsome<A> (the vptr of A and the data pointer, the SBO) plus a pointer to a static
+/// table of the vptrs of impl<A, T*>, impl<B, T*>, impl<C, T*> (one table per T, filled in on the first use).
+/// - `->` and `*` call the first trait through the inline vptr, same as fsome
+/// - as<B>() is a load from the table at an index known at compile time, no dynamic_cast: a flat_view<B> of the same T
+/// - the object is 3 pointers (+ the SBO) for any number of traits and the T is stored as is, not wrapped into an impl
+///@note: the same impl<Trait, T> specializations as with some<> are used (impl<Trait, T*> for each of the mixed traits)
+///@note: copy, move and destruction go through the first trait, as with fsome
+template <typename... Traits, cfg::fsome config>
+class flat_some<mix<Traits...>, config> : public basic_operations_for<flat_some<mix<Traits...>, config>, first_trait_from<mix<Traits...>>> {
+    using main_trait_t = first_trait_from<mix<Traits...>>;
+    using object_t = fsome<main_trait_t, config>;
+    using table_t = detail::flat_table<sizeof...(Traits)>;
+
+    template <typename SubTrait>
+    static constexpr std::size_t index_of = detail::index_in<SubTrait, Traits...>;
+
+public:
+    template <typename X>
+    using impl_type = typename object_t::template impl_type<X>;
+
+    flat_some() requires (config.empty_state) = default;
+
+    template <typename T>
+    requires (not polymorphic<T> && std::is_constructible_v<object_t, T&&>)
+    flat_some(T && obj)
+    : object_{std::forward<T>(obj)}, table_{&detail::flat_table_for<std::remove_cvref_t<T>, Traits...>()} {}
+
+    template <typename T>
+    requires (not polymorphic<T> && std::is_assignable_v<object_t&, T&&>)
+    flat_some& operator= (T && obj) {
+        object_ = std::forward<T>(obj);
+        table_ = &detail::flat_table_for<std::remove_cvref_t<T>, Traits...>();
+        return *this;
+    }
+
+    /// the SubTrait of the object: the vptr is taken from the table, the data pointer is the one of the object
+    template <typename SubTrait>
+    flat_view<SubTrait> as() noexcept(not config.check_empty) {
+        return view<SubTrait>();
+    }
+
+    template <typename SubTrait>
+    flat_view<const SubTrait> as() const noexcept(not config.check_empty) {
+        return view<const SubTrait>();
+    }
+
+    explicit operator bool() const noexcept { return object_.vptr() != nullptr; }
+
+    /// trait narrowing to the first trait: the fsome inside is handed over as is, the T isn't touched
+    operator fsome<main_trait_t, config>() && noexcept { return std::move(object_); }
+
+    /// the T goes into an impl<first trait, T> of the some<>, a heap-resident one as is (see some(fsome&&))
+    template <cfg::some some_config>
+    requires (config.move)
+    operator some<main_trait_t, some_config>() && { return some<main_trait_t, some_config>{std::move(object_)}; }
+
+protected:
+    friend struct basic_operations_for<flat_some<mix<Traits...>, config>, main_trait_t>;
+
+    auto* trait_ptr() noexcept(not config.check_empty) { return object_.operator->(); }
+    auto const* trait_ptr() const noexcept(not config.check_empty) { return object_.operator->(); }
+
+private:
+    template <typename SubTrait>
+    flat_view<SubTrait> view() const noexcept(not config.check_empty) {
+        static_assert(index_of<std::remove_const_t<SubTrait>> < sizeof...(Traits), "Trait not in the list of mixed traits");
+        if (object_.vptr() == nullptr) {
+            if constexpr (config.check_empty) { throw empty_some_access{"empty flat_some<> accessed"}; }
+            return {nullptr, nullptr};
+        }
+        return {table_->vptrs[index_of<std::remove_const_t<SubTrait>>], const_cast<void*>(object_.data())};
+    }
+
+    object_t object_;
+    table_t const* table_ = nullptr; ///< stays behind in a moved-from flat_some, unused while it's empty
+};
+
+} // namespace vx
@@ -0,0 +1,121 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <functional> // invoke, bad_function_call
+#include <type_traits>
+#include <utility> // exchange, forward, move
+
+#include "some.hpp"
+
+namespace vx {
+
+template <typename Signature, cfg::some config = cfg::some{}>
+class fn_some;
+
+namespace detail {
+/// the trait behind fn_some: only the lifetime management of vx::trait (copy, move, cleanup),
+/// the call itself doesn't go through the vtable
+template <typename Signature>
+struct fn_trait : vx::trait {};
+
+/// a function pointer is held as a callable object, impl_for would take a T* for a pointer to the object itself
+template <typename P>
+struct fn_ptr {
+    P p;
+    template <typename... Args>
+    decltype(auto) operator() (Args&&... args) const { return std::invoke(p, std::forward<Args>(args)...); }
+};
+
+/// the invoker takes the scalars by value (in the registers), the rest by reference
+template <typename T>
+using fn_param_t = std::conditional_t<std::is_scalar_v<T>, T, T&&>;
+
+template <typename F>
+using fn_stored_t = std::conditional_t<std::is_pointer_v<std::decay_t<F>>, fn_ptr<std::decay_t<F>>, std::decay_t<F>>;
+}// namespace detail
+
+template <typename Signature, typename F>
+struct impl<detail::fn_trait<Signature>, F> : impl_for<detail::fn_trait<Signature>, F> {
+    using impl_for<detail::fn_trait<Signature>, F>::impl_for;
+    using impl_for<detail::fn_trait<Signature>, F>::self;
+};
+
+
+/// ===== [ FN SOME ] =====
+///@brief: A std::function-like owning callable on top of some<>, for the single-method Callable<R(Args...)> traits.
+/// The invoker function pointer is kept inline next to the some<> (its SBO buffer and the object pointer),
+/// so a call is a single indirect jump, instead of loading the vptr, then the slot, then jumping.
+/// Copying, moving, SBO and memory resources are all some<>'s, as configured by the `config`
+///@note: a call through a const fn_some calls the non-const target, as with std::function
+///@note: calling an empty one throws std::bad_function_call, with or without the check_empty
+///@note: copyable only with config.copy
+template <typename R, typename... Args, cfg::some config>
+class fn_some<R(Args...), config> {
+    using trait_t = detail::fn_trait<R(Args...)>;
+    using invoker_t = R (*)(trait_t*, detail::fn_param_t<Args>...);
+
+public:
+    fn_some() noexcept requires(config.empty_state) = default;
+
+    template <typename F>
+    requires (not std::is_same_v<std::remove_cvref_t<F>, fn_some> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    fn_some(F && f) : object_{detail::fn_stored_t<F>(std::forward<F>(f))}, invoke_{&invoke<detail::fn_stored_t<F>>} {}
+
+    /// copyable only if the some<> is configured to copy (its copy would come out empty otherwise)
+    fn_some(fn_some const&) requires (config.copy) = default;
+
+    /// copy-and-move: safe for the self-assignment (the some<> is cleared before it's copied into), and `this` is
+    /// left as it was if the copy throws
+    fn_some& operator= (fn_some const& other) requires (config.copy) {
+        fn_some copy {other};
+        return *this = std::move(copy);
+    }
+
+    /// the moved-from fn_some is left empty
+    fn_some(fn_some && other) noexcept
+    : object_{std::move(other.object_)}, invoke_{std::exchange(other.invoke_, &empty_call)} {}
+
+    fn_some& operator= (fn_some && other) noexcept {
+        if (this == &other) { return *this; }
+        object_ = std::move(other.object_);
+        invoke_ = std::exchange(other.invoke_, &empty_call);
+        return *this;
+    }
+
+    template <typename F>
+    requires (not std::is_same_v<std::remove_cvref_t<F>, fn_some> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    fn_some& operator= (F && f) {
+        object_ = detail::fn_stored_t<F>(std::forward<F>(f));
+        invoke_ = &invoke<detail::fn_stored_t<F>>;
+        return *this;
+    }
+
+    R operator() (Args... args) const {
+        if constexpr (config.check_empty) {
+            if (invoke_ == &empty_call) { throw std::bad_function_call{}; } // before the some<>'s own check
+        }
+        return invoke_(const_cast<trait_t*>(object_.operator->()), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return invoke_ != &empty_call; }
+
+private:
+    template <typename F>
+    static R invoke(trait_t * object, detail::fn_param_t<Args>... args) {
+        auto & f = static_cast<impl<trait_t, F>*>(object)->self();
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(f, std::forward<Args>(args)...);
+        } else {
+            return std::invoke(f, std::forward<Args>(args)...);
+        }
+    }
+
+    [[noreturn]] static R empty_call(trait_t *, detail::fn_param_t<Args>...) { throw std::bad_function_call{}; }
+
+    some<trait_t, config> object_;
+    invoker_t invoke_ = &empty_call;
+};
+
+} // namespace vx
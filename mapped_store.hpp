@@ -0,0 +1,265 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <cstddef> // byte, size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <cstring> // memcpy, strerror
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility> // exchange, swap
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <cerrno>
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
+#define VX_HAS_MMAP 1
+#else
+#define VX_HAS_MMAP 0
+#endif
+
+#include "serialization.hpp"
+
+namespace vx {
+
+namespace detail {
+    /// the layout of a mapped_store file, all of it in the native byte order:
+    /// [header] [type table: header.type_count x store_type] [index: header.record_count x store_record] [payloads]
+    struct store_header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t type_count;
+        std::uint64_t record_count;
+        std::uint64_t size; ///< of the whole file
+    };
+
+    struct store_type {
+        std::uint32_t id; ///< the type_registry id
+        std::uint32_t size;
+        std::uint32_t alignment;
+        std::uint32_t reserved;
+    };
+
+    struct store_record {
+        std::uint32_t type; ///< the index in the type table
+        std::uint32_t reserved;
+        std::uint64_t offset; ///< of the payload, from the start of the file
+    };
+
+    inline constexpr char store_magic[8] = {'v', 'x', 's', 't', 'o', 'r', 'e', '\0'};
+    inline constexpr std::uint32_t store_version = 1;
+
+    /// the payloads are aligned relative to the start of the file, the file is to be placed at least that aligned
+    inline constexpr std::size_t store_alignment = alignof(std::max_align_t);
+
+    inline std::uint64_t align_up(std::uint64_t offset, std::uint64_t alignment) noexcept {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+}// namespace detail
+
+
+/// ===== [ MAPPED STORE ] =====
+///@brief: Read-only polymorphic lookup tables straight out of a file: the records are trivially copyable payloads,
+/// the views into them are poly_view<Trait> (the vptr of the impl<Trait, T&>, the address of the T in the mapping),
+/// nothing is deserialized and nothing is allocated per object.
+/// - write(): saves the some<Trait>s / fsome<Trait>s (the trivially copyable ones, registered in a type_registry<Trait>)
+/// - open(): maps the file (POSIX mmap), the file's type ids are resolved to the vptrs once, at load;
+///   the payload pages are only touched when viewed
+/// - or over any memory that holds such a file (a buffer, a mapping of your own): mapped_store(bytes, registry)
+///@note: mapped_store<const Trait> maps the file read-only and gives poly_view<const Trait> (some<Trait const&>'s base);
+/// mapped_store<Trait> maps it copy-on-write, the non-const trait methods can modify the objects, the file stays as it is
+///@note: the vptrs are resolved by the type ids (they are the format), so the file outlives the build that wrote it,
+/// as long as the size and the alignment of the types are the same, which is checked at load
+///@note: operator[] doesn't check the record, at() does
+template <typename Trait>
+class mapped_store {
+    using raw_trait_t = std::remove_cv_t<Trait>;
+    using registry_t = type_registry<raw_trait_t>;
+    using byte_t = std::conditional_t<std::is_const_v<Trait>, const std::byte, std::byte>;
+
+public:
+    using view = poly_view<Trait>;
+
+    ///@brief: writes the objects in the mapped_store format, the empty objects aren't allowed
+    ///@throws serialization_error: an empty object, or a type that isn't registered or isn't trivially copyable
+    template <typename Object, typename Alloc>
+    static void write(binary_writer & out, registry_t const& registry, std::vector<Object, Alloc> const& objects) {
+        std::vector<detail::store_type> types;
+        std::vector<detail::store_record> records;
+        std::vector<const void*> payloads;
+        records.reserve(objects.size());
+        payloads.reserve(objects.size());
+
+        typename registry_t::writer_entry const* last = nullptr;
+        std::uint32_t last_type = 0;
+        for (auto const& object : objects) {
+            auto const* p = registry_t::object_of(object);
+            if (p == nullptr) { throw serialization_error{"vx::mapped_store: empty objects can't be stored"}; }
+            if (auto const& entry = registry.writer_of(p, last); &entry != last) {
+                last = &entry;
+                last_type = type_index(registry, types, entry.id);
+            }
+            records.push_back({last_type, 0, 0});
+            payloads.push_back(last->payload(p));
+        }
+
+        std::uint64_t offset = sizeof(detail::store_header)
+                             + types.size() * sizeof(detail::store_type) + records.size() * sizeof(detail::store_record);
+        for (auto & record : records) {
+            offset = detail::align_up(offset, types[record.type].alignment);
+            record.offset = offset;
+            offset += types[record.type].size;
+        }
+
+        detail::store_header header {{}, detail::store_version, static_cast<std::uint32_t>(types.size()), records.size(), offset};
+        std::memcpy(header.magic, detail::store_magic, sizeof(header.magic));
+        out.write(header);
+        out.write_bytes(types.data(), types.size() * sizeof(detail::store_type));
+        out.write_bytes(records.data(), records.size() * sizeof(detail::store_record));
+
+        std::uint64_t position = sizeof(detail::store_header)
+                               + types.size() * sizeof(detail::store_type) + records.size() * sizeof(detail::store_record);
+        static constexpr std::byte padding[detail::store_alignment] {};
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            out.write_bytes(padding, records[i].offset - position);
+            out.write_bytes(payloads[i], types[records[i].type].size);
+            position = records[i].offset + types[records[i].type].size;
+        }
+    }
+
+    ///@brief: maps the file
+    ///@throws serialization_error: the file can't be mapped, isn't a mapped_store file, or has a type unknown to the registry
+    static mapped_store open(std::string const& path, registry_t const& registry) {
+#if VX_HAS_MMAP
+        int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) { throw serialization_error{"vx::mapped_store: can't open " + path + ": " + std::strerror(errno)}; }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            throw serialization_error{"vx::mapped_store: can't map " + path};
+        }
+        auto const size = static_cast<std::size_t>(info.st_size);
+        int const protection = std::is_const_v<Trait> ? PROT_READ : PROT_READ | PROT_WRITE;
+        void * address = ::mmap(nullptr, size, protection, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) { throw serialization_error{"vx::mapped_store: can't map " + path + ": " + std::strerror(errno)}; }
+
+        mapped_store store;
+        store.mapping_ = {static_cast<byte_t*>(address), size};
+        store.bytes_ = store.mapping_;
+        store.load(registry);
+        return store;
+#else
+        (void)path; (void)registry;
+        throw serialization_error{"vx::mapped_store: no mmap on this platform, map the file and use mapped_store(bytes, registry)"};
+#endif
+    }
+
+    ///@brief: over the memory that holds a mapped_store file, not owned, aligned to alignof(std::max_align_t)
+    ///@throws serialization_error: same as open()
+    mapped_store(std::span<byte_t> bytes, registry_t const& registry) : bytes_{bytes} {
+        load(registry);
+    }
+
+    mapped_store(mapped_store && other) noexcept
+    : bytes_{std::exchange(other.bytes_, {})}, mapping_{std::exchange(other.mapping_, {})}, types_{std::move(other.types_)} {}
+
+    mapped_store& operator= (mapped_store other) noexcept {
+        std::swap(bytes_, other.bytes_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(types_, other.types_);
+        return *this;
+    }
+
+    ~mapped_store() {
+#if VX_HAS_MMAP
+        if (not mapping_.empty()) { ::munmap(const_cast<std::byte*>(mapping_.data()), mapping_.size()); }
+#endif
+    }
+
+    std::size_t size() const noexcept { return bytes_.empty() ? 0 : header().record_count; }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    view operator[] (std::size_t i) const noexcept {
+        auto const& record = records()[i];
+        return view{typename view::from_bits_t{}, types_[record.type].vptr, bytes_.data() + record.offset};
+    }
+
+    ///@throws serialization_error: the index or the record is out of bounds
+    view at(std::size_t i) const {
+        if (i >= size()) { throw serialization_error{"vx::mapped_store: index out of range"}; }
+        auto const& record = records()[i];
+        if (record.type >= types_.size() || record.offset > bytes_.size() || bytes_.size() - record.offset < types_[record.type].size
+            || record.offset % types_[record.type].alignment != 0) {
+            throw serialization_error{"vx::mapped_store: corrupt record"};
+        }
+        return (*this)[i];
+    }
+
+    /// the type id the record was written with
+    typename registry_t::type_id id_of(std::size_t i) const noexcept { return types()[records()[i].type].id; }
+
+private:
+    mapped_store() = default;
+
+    static std::uint32_t type_index(registry_t const& registry, std::vector<detail::store_type> & types, std::uint32_t id) {
+        for (std::size_t i = 0; i < types.size(); ++i) {
+            if (types[i].id == id) { return static_cast<std::uint32_t>(i); }
+        }
+        auto it = registry.views_.find(id);
+        if (it == registry.views_.end()) { throw serialization_error{"vx::mapped_store: only the trivially copyable types can be stored"}; }
+        if (it->second.alignment > detail::store_alignment) { throw serialization_error{"vx::mapped_store: over-aligned type"}; }
+        types.push_back({id, it->second.size, it->second.alignment, 0});
+        return static_cast<std::uint32_t>(types.size() - 1);
+    }
+
+    detail::store_header const& header() const noexcept { return *reinterpret_cast<detail::store_header const*>(bytes_.data()); }
+
+    detail::store_type const* types() const noexcept {
+        return reinterpret_cast<detail::store_type const*>(bytes_.data() + sizeof(detail::store_header));
+    }
+
+    detail::store_record const* records() const noexcept {
+        return reinterpret_cast<detail::store_record const*>(types() + header().type_count);
+    }
+
+    /// checks the header and the type table, resolves the type ids to the vptrs
+    void load(registry_t const& registry) {
+        if (reinterpret_cast<std::uintptr_t>(bytes_.data()) % detail::store_alignment != 0) {
+            throw serialization_error{"vx::mapped_store: the memory isn't aligned"};
+        }
+        if (bytes_.size() < sizeof(detail::store_header)
+            || std::memcmp(header().magic, detail::store_magic, sizeof(detail::store_magic)) != 0) {
+            throw serialization_error{"vx::mapped_store: not a mapped_store file"};
+        }
+        auto const& h = header();
+        if (h.version != detail::store_version) { throw serialization_error{"vx::mapped_store: unsupported version"}; }
+        auto const tables = sizeof(detail::store_header) + std::uint64_t{h.type_count} * sizeof(detail::store_type);
+        if (h.size != bytes_.size() || tables > h.size || (h.size - tables) / sizeof(detail::store_record) < h.record_count) {
+            throw serialization_error{"vx::mapped_store: truncated file"};
+        }
+
+        types_.reserve(h.type_count);
+        for (std::uint32_t i = 0; i < h.type_count; ++i) {
+            auto const& type = types()[i];
+            auto it = registry.views_.find(type.id);
+            if (it == registry.views_.end()) { throw serialization_error{"vx::mapped_store: unknown type id"}; }
+            if (it->second.size != type.size || it->second.alignment != type.alignment || type.alignment > detail::store_alignment) {
+                throw serialization_error{"vx::mapped_store: the layout of a type has changed"};
+            }
+            types_.push_back(it->second);
+        }
+    }
+
+    std::span<byte_t> bytes_;
+    std::span<byte_t> mapping_; ///< owned, when opened from a file
+    std::vector<typename registry_t::view_entry> types_; ///< by the index in the type table
+};
+
+} // namespace vx
@@ -0,0 +1,339 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // max, min
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <exception> // exception_ptr
+#include <iterator>
+#include <memory> // unique_ptr
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility> // forward, move
+#include <vector>
+
+#include "batched.hpp"
+#include "poly_collection.hpp"
+#include "poly_vector.hpp"
+
+namespace vx {
+
+/// ===== [ THREAD POOL ] =====
+///@brief: A fork-join pool for the parallel algorithms below: `run(n, task)` calls task(i) for every i in [0, n)
+/// on the workers and the calling thread, and returns when all of them are done.
+/// The indices are dealt out in equal contiguous runs, one per thread (so neighbouring chunks go to the same thread),
+/// a thread that ran out of its own steals the back half of the run of another one.
+/// - one run() at a time, the concurrent calls from other threads wait for their turn
+/// - a run() from inside a task of the same pool runs the tasks right away on the calling thread
+/// - the first exception thrown by a task cancels the tasks not started yet and is rethrown from run()
+///@note: the tasks are meant to be coarse (chunks of a range), the runs of indices are guarded by a mutex each
+class thread_pool {
+public:
+    /// the calling thread counts, so there are `concurrency - 1` workers
+    explicit thread_pool(std::size_t concurrency = std::max(1u, std::thread::hardware_concurrency()))
+    : lanes_{std::make_unique<lane[]>(std::max<std::size_t>(concurrency, 1))}
+    , concurrency_{std::max<std::size_t>(concurrency, 1)} {
+        workers_.reserve(concurrency_ - 1);
+        for (std::size_t i = 1; i < concurrency_; ++i) {
+            workers_.emplace_back([this, i] { work_loop(i); });
+        }
+    }
+
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator= (thread_pool const&) = delete;
+
+    ~thread_pool() {
+        {
+            std::lock_guard lock {mutex_};
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto & worker : workers_) { worker.join(); }
+    }
+
+    /// the workers and the calling thread
+    std::size_t concurrency() const noexcept { return concurrency_; }
+
+    template <typename F>
+    void run(std::size_t n, F && task) {
+        if (n == 0) { return; }
+        if (n == 1 || concurrency_ == 1 || running_ == this) {
+            for (std::size_t i = 0; i < n; ++i) { task(i); }
+            return;
+        }
+
+        using Fn = std::remove_reference_t<F>;
+        job current {(void*)&task, [](void * fn, std::size_t i) { (*static_cast<Fn*>(fn))(i); }};
+        std::lock_guard turn {run_mutex_};
+        for (std::size_t l = 0; l < concurrency_; ++l) {
+            lanes_[l].first = n * l / concurrency_;
+            lanes_[l].last = n * (l + 1) / concurrency_;
+        }
+        {
+            std::lock_guard lock {mutex_};
+            job_ = &current;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        auto * const outer = std::exchange(running_, this);
+        work(0, current);
+        running_ = outer;
+
+        {
+            std::unique_lock lock {mutex_};
+            job_ = nullptr; // nothing left to take, the late workers stay asleep
+            done_.wait(lock, [this] { return busy_ == 0; });
+        }
+        if (current.error) { std::rethrow_exception(current.error); }
+    }
+
+    /// the pool the parallel algorithms use by default, one thread per core
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+private:
+    struct job {
+        void * fn;
+        void (*call)(void*, std::size_t);
+        std::atomic<bool> failed {false};
+        std::exception_ptr error {};
+    };
+
+    /// the indices [first, last) yet to be taken, the owner takes from the front, the thieves from the back
+    struct alignas(64) lane {
+        std::mutex mutex;
+        std::size_t first = 0;
+        std::size_t last = 0;
+    };
+
+    void work_loop(std::size_t self) {
+        running_ = this;
+        std::uint64_t seen = 0;
+        for (;;) {
+            std::unique_lock lock {mutex_};
+            wake_.wait(lock, [&] { return stop_ || (job_ != nullptr && generation_ != seen); });
+            if (stop_) { return; }
+            seen = generation_;
+            job & current = *job_;
+            ++busy_;
+            lock.unlock();
+
+            work(self, current);
+
+            lock.lock();
+            if (--busy_ == 0) { done_.notify_all(); }
+        }
+    }
+
+    void work(std::size_t self, job & current) noexcept {
+        std::size_t index;
+        while (take(self, index)) {
+            if (current.failed.load(std::memory_order_relaxed)) { continue; } // drained, not run
+            try {
+                current.call(current.fn, index);
+            } catch (...) {
+                if (not current.failed.exchange(true)) { current.error = std::current_exception(); }
+            }
+        }
+    }
+
+    /// the next index of the own lane, or the first of the back half stolen from another one (the rest goes to the own lane)
+    bool take(std::size_t self, std::size_t & index) {
+        {
+            auto & own = lanes_[self];
+            std::lock_guard lock {own.mutex};
+            if (own.first < own.last) { index = own.first++; return true; }
+        }
+        for (std::size_t k = 1; k < concurrency_; ++k) {
+            auto & victim = lanes_[(self + k) % concurrency_];
+            std::size_t first, last;
+            {
+                std::lock_guard lock {victim.mutex};
+                if (victim.first == victim.last) { continue; }
+                last = victim.last;
+                first = victim.last -= (victim.last - victim.first + 1) / 2;
+            }
+            // the own lane is empty and only its owner ever fills it
+            auto & own = lanes_[self];
+            std::lock_guard lock {own.mutex};
+            own.first = first + 1;
+            own.last = last;
+            index = first;
+            return true;
+        }
+        return false;
+    }
+
+    static inline thread_local thread_pool const* running_ = nullptr; ///< the pool whose task is running on this thread
+
+    std::unique_ptr<lane[]> lanes_;
+    std::size_t concurrency_;
+    std::vector<std::thread> workers_;
+
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    job * job_ = nullptr;
+    std::uint64_t generation_ = 0;
+    std::size_t busy_ = 0;
+    bool stop_ = false;
+};
+
+
+namespace detail {
+    template <typename> struct is_poly_collection : std::false_type {};
+    template <typename Trait> struct is_poly_collection<poly_collection<Trait>> : std::true_type {};
+
+    template <typename> struct is_type_groups : std::false_type {};
+    template <typename It> struct is_type_groups<type_groups<It>> : std::true_type {};
+
+    /// the chunks: about 8 per thread, so that the stealing can even out the uneven ones, but no fewer than 64 elements
+    inline std::size_t chunk_size(std::size_t n, thread_pool const& pool) noexcept {
+        return std::max<std::size_t>(64, (n + 8 * pool.concurrency() - 1) / (8 * pool.concurrency()));
+    }
+
+    inline std::size_t chunk_count(std::size_t n, std::size_t chunk) noexcept { return (n + chunk - 1) / chunk; }
+
+    /// a piece of a segment (or a type group): all the elements of one type
+    struct span_chunk {
+        std::size_t segment;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    template <typename Sizes>
+    std::vector<span_chunk> split_segments(std::size_t count, Sizes size_of, thread_pool const& pool) {
+        std::size_t total = 0;
+        for (std::size_t s = 0; s < count; ++s) { total += size_of(s); }
+        std::size_t const chunk = chunk_size(total, pool);
+        std::vector<span_chunk> chunks;
+        for (std::size_t s = 0; s < count; ++s) {
+            for (std::size_t first = 0, size = size_of(s); first < size; first += chunk) {
+                chunks.push_back({s, first, std::min(first + chunk, size)});
+            }
+        }
+        return chunks;
+    }
+
+    /// calls visit(f) for every chunk, where f is the element function: the pieces of the polymorphic containers
+    /// are visited with all the elements of one type back to back wherever the type is known
+    template <typename... Ts, typename R, typename Visit>
+    void for_each_chunk(thread_pool & pool, R && range, Visit && visit) {
+        using range_t = std::remove_cvref_t<R>;
+        if constexpr (is_poly_collection<range_t>::value) {
+            auto const chunks = split_segments(range.segment_count(), [&](std::size_t s) { return range.segment_size(s); }, pool);
+            pool.run(chunks.size(), [&](std::size_t c) {
+                visit(c, [&](auto && f) { range.template for_each_in<Ts...>(chunks[c].segment, chunks[c].first, chunks[c].last, f); });
+            });
+        } else if constexpr (is_type_groups<range_t>::value) {
+            auto const chunks = split_segments(range.size(), [&](std::size_t g) { return range[g].items.size(); }, pool);
+            pool.run(chunks.size(), [&](std::size_t c) {
+                visit(c, [&](auto && f) {
+                    for (auto const& it : range[chunks[c].segment].items.subspan(chunks[c].first, chunks[c].last - chunks[c].first)) { f(*it); }
+                });
+            });
+        } else if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>) {
+            auto const first = std::ranges::begin(range);
+            std::size_t const n = std::ranges::size(range);
+            std::size_t const chunk = chunk_size(n, pool);
+            pool.run(chunk_count(n, chunk), [&](std::size_t c) {
+                auto const begin = first + static_cast<std::ptrdiff_t>(c * chunk);
+                auto const end = first + static_cast<std::ptrdiff_t>(std::min(n, (c + 1) * chunk));
+                visit(c, [&](auto && f) { for (auto it = begin; it != end; ++it) { f(*it); } });
+            });
+        } else { // poly_vector and the like: indexed, with forward iterators
+            std::size_t const n = range.size();
+            std::size_t const chunk = chunk_size(n, pool);
+            pool.run(chunk_count(n, chunk), [&](std::size_t c) {
+                visit(c, [&](auto && f) {
+                    for (std::size_t i = c * chunk, end = std::min(n, (c + 1) * chunk); i < end; ++i) { f(range[i]); }
+                });
+            });
+        }
+    }
+
+    template <typename R>
+    std::size_t chunks_upper_bound(R const& range, thread_pool const& pool) {
+        using range_t = std::remove_cvref_t<R>;
+        if constexpr (is_poly_collection<range_t>::value) {
+            std::size_t total = 0;
+            for (std::size_t s = 0; s < range.segment_count(); ++s) { total += range.segment_size(s); }
+            return chunk_count(total, chunk_size(total, pool)) + range.segment_count();
+        } else if constexpr (is_type_groups<range_t>::value) {
+            std::size_t total = 0;
+            for (auto const& group : range) { total += group.items.size(); }
+            return chunk_count(total, chunk_size(total, pool)) + range.size();
+        } else {
+            std::size_t const n = std::ranges::size(range);
+            return chunk_count(n, chunk_size(n, pool));
+        }
+    }
+}// namespace detail
+
+/// the ranges the parallel algorithms take
+template <typename R>
+concept parallel_range = detail::is_poly_collection<std::remove_cvref_t<R>>::value
+                      || detail::is_type_groups<std::remove_cvref_t<R>>::value
+                      || (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+                      || requires (R & r, std::size_t i) { { r.size() } -> std::convertible_to<std::size_t>; r[i]; };
+
+
+/// ===== [ PARALLEL ALGORITHMS ] =====
+///@brief: for_each / transform_reduce over the polymorphic ranges, split into chunks run on a thread_pool:
+///     vx::parallel_for_each(shapes, [](auto & shape) { shape->update(dt); });
+///     int total = vx::parallel_transform_reduce(std::as_const(shapes), 0, std::plus{}, [](auto const& s) { return s->area(); });
+/// - random access ranges of some<> / fsome<> (and of anything else): contiguous chunks
+/// - type_groups of fsome<>: the chunks are pieces of the groups, so every one of them is of a single type;
+///   grouping costs about as much as a pass of cheap calls, so it pays off when the groups are reused across the passes
+/// - poly_collection: the chunks are pieces of the segments, f(T&) for the listed Ts..., f(Trait&) for the rest
+/// - poly_vector: contiguous chunks by index
+/// The elements are passed the way the range gives them, const for a const range: a const range can only
+/// be read through the const methods of the trait, which are safe to call concurrently on the distinct objects.
+///@note: f (transform, reduce) is called concurrently, from many threads, on the distinct elements
+///@note: the order is unspecified, so the reduce is expected to be associative and commutative
+template <typename... Ts, parallel_range R, typename F>
+void parallel_for_each(thread_pool & pool, R && range, F && f) {
+    detail::for_each_chunk<Ts...>(pool, range, [&](std::size_t, auto && chunk) { chunk(f); });
+}
+
+template <typename... Ts, parallel_range R, typename F>
+void parallel_for_each(R && range, F && f) {
+    parallel_for_each<Ts...>(thread_pool::shared(), std::forward<R>(range), std::forward<F>(f));
+}
+
+template <typename... Ts, parallel_range R, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(thread_pool & pool, R && range, T init, Reduce && reduce, Transform && transform) {
+    // one partial result per chunk, reduced in the order of the chunks at the end
+    std::vector<std::optional<T>> partials(detail::chunks_upper_bound(range, pool));
+    detail::for_each_chunk<Ts...>(pool, range, [&](std::size_t c, auto && chunk) {
+        std::optional<T> & partial = partials[c];
+        chunk([&](auto && item) {
+            if (partial) { *partial = reduce(std::move(*partial), transform(item)); }
+            else { partial.emplace(transform(item)); }
+        });
+    });
+    for (auto & partial : partials) {
+        if (partial) { init = reduce(std::move(init), std::move(*partial)); }
+    }
+    return init;
+}
+
+template <typename... Ts, parallel_range R, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(R && range, T init, Reduce && reduce, Transform && transform) {
+    return parallel_transform_reduce<Ts...>(thread_pool::shared(), std::forward<R>(range), std::move(init),
+                                            std::forward<Reduce>(reduce), std::forward<Transform>(transform));
+}
+
+} // namespace vx
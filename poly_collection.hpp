@@ -0,0 +1,271 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <cassert>
+#include <concepts> // invocable
+#include <cstddef> // size_t
+#include <iterator> // forward_iterator_tag
+#include <memory> // unique_ptr
+#include <span>
+#include <utility> // as_const
+#include <vector>
+
+#include "some.hpp"
+
+namespace vx {
+
+/// ===== [ POLY COLLECTION ] =====
+///@brief: A polymorphic collection that keeps the objects segregated by their type:
+/// one contiguous segment (a std::vector<T>) per dynamic type, keyed by the impl<Trait, T>.
+/// `for_each<Ts...>(f)` runs through the segments of the listed types calling f(T&), with no virtual call
+/// per element, so the inner loops are branch-predictable and inlinable. The rest of the segments
+/// (and the plain `for_each(f)`) fall back to f(Trait&) through a some<Trait&> view of every element.
+///@note: the order is by segment (in the order the types were first inserted), then by insertion
+///@note: move-only
+template <typename Trait>
+class poly_collection {
+    struct segment_base {
+        explicit segment_base(void const* key) noexcept : key{key} {}
+        segment_base(segment_base const&) = delete;
+        virtual ~segment_base() = default;
+
+        virtual std::size_t size() const noexcept = 0;
+        virtual some<Trait&> view(std::size_t index) noexcept = 0;
+        virtual some<Trait const&> view(std::size_t index) const noexcept = 0;
+        /// over the items [first, last)
+        virtual void for_each(std::size_t first, std::size_t last, void * f, void (*call)(void*, Trait&)) = 0;
+        virtual void for_each(std::size_t first, std::size_t last, void * f, void (*call)(void*, Trait const&)) const = 0;
+        virtual void clear() noexcept = 0;
+
+        void const* const key; ///< detail::type_key of the impl<Trait, T>
+    };
+
+    template <typename T>
+    struct typed_segment final : segment_base {
+        typed_segment() noexcept : segment_base{&detail::type_key<impl<Trait, T>>} {}
+
+        std::size_t size() const noexcept override { return items.size(); }
+        some<Trait&> view(std::size_t index) noexcept override { return some<Trait&>{items[index]}; }
+        some<Trait const&> view(std::size_t index) const noexcept override { return some<Trait const&>{items[index]}; }
+
+        void for_each(std::size_t first, std::size_t last, void * f, void (*call)(void*, Trait&)) override {
+            for (T & item : std::span<T>{items}.subspan(first, last - first)) { call(f, *some<Trait&>{item}); }
+        }
+
+        void for_each(std::size_t first, std::size_t last, void * f, void (*call)(void*, Trait const&)) const override {
+            for (T const& item : std::span<T const>{items}.subspan(first, last - first)) { call(f, *some<Trait const&>{item}); }
+        }
+
+        void clear() noexcept override { items.clear(); }
+
+        std::vector<T> items;
+    };
+
+    template <bool is_const>
+    class basic_iterator {
+        friend class poly_collection;
+
+        using segments_t = std::conditional_t<is_const, std::vector<std::unique_ptr<segment_base>> const,
+                                                        std::vector<std::unique_ptr<segment_base>>>;
+
+        basic_iterator(segments_t * segments, std::size_t segment) noexcept : segments_{segments}, segment_{segment} {
+            skip_empty();
+        }
+
+        void skip_empty() noexcept {
+            while (segment_ < segments_->size() && index_ == (*segments_)[segment_]->size()) {
+                ++segment_;
+                index_ = 0;
+            }
+        }
+
+        segments_t * segments_ = nullptr;
+        std::size_t segment_ = 0;
+        std::size_t index_ = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::conditional_t<is_const, some<Trait const&>, some<Trait&>>;
+        using difference_type = std::ptrdiff_t;
+
+        basic_iterator() = default;
+
+        value_type operator*() const noexcept {
+            if constexpr (is_const) {
+                return std::as_const(*(*segments_)[segment_]).view(index_);
+            } else {
+                return (*segments_)[segment_]->view(index_);
+            }
+        }
+
+        basic_iterator& operator++() noexcept { ++index_; skip_empty(); return *this; }
+        basic_iterator operator++(int) noexcept { auto copy = *this; ++*this; return copy; }
+
+        bool operator==(basic_iterator const& other) const noexcept {
+            return segment_ == other.segment_ && index_ == other.index_;
+        }
+    };
+
+public:
+    /// yields a some<Trait&> view of every element
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    poly_collection() = default;
+    poly_collection(poly_collection &&) noexcept = default;
+    poly_collection& operator= (poly_collection &&) noexcept = default;
+
+    template <typename T, typename... Args>
+    requires (std::constructible_from<T, Args...>)
+    T& emplace(Args&&... args) {
+        return segment_for<T>().items.emplace_back(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    requires (not polymorphic<T>)
+    auto& insert(T && obj) {
+        return emplace<std::remove_cvref_t<T>>(std::forward<T>(obj));
+    }
+
+    /// f(T&) for the objects of the listed types, f(Trait&) for the rest
+    template <typename... Ts, typename F>
+    void for_each(F && f) {
+        for (std::size_t s = 0; s < segments_.size(); ++s) { for_each_in<Ts...>(s, 0, segments_[s]->size(), f); }
+    }
+
+    template <typename... Ts, typename F>
+    void for_each(F && f) const {
+        for (std::size_t s = 0; s < segments_.size(); ++s) { for_each_in<Ts...>(s, 0, segments_[s]->size(), f); }
+    }
+
+    /// for_each<Ts...>(f) over the elements [first, last) of one segment, see segment_count()
+    template <typename... Ts, typename F>
+    void for_each_in(std::size_t segment, std::size_t first, std::size_t last, F && f) {
+        using Fn = std::remove_reference_t<F>;
+        auto & seg = *segments_[segment];
+        if (not (... || typed_for_each<Ts>(seg, first, last, f))) {
+            seg.for_each(first, last, (void*)&f, [](void * fn, Trait & item) { (*static_cast<Fn*>(fn))(item); });
+        }
+    }
+
+    template <typename... Ts, typename F>
+    void for_each_in(std::size_t segment, std::size_t first, std::size_t last, F && f) const {
+        using Fn = std::remove_reference_t<F>;
+        auto const& seg = *segments_[segment];
+        if (not (... || typed_for_each<Ts>(seg, first, last, f))) {
+            seg.for_each(first, last, (void*)&f, [](void * fn, Trait const& item) { (*static_cast<Fn*>(fn))(item); });
+        }
+    }
+
+    /// out[i] = op(the i-th element), in the order of iteration; `out` has room for size() results.
+    /// For the segments of the listed Ts the op is called once per segment in its batch form
+    /// op(std::span<T const>, std::span<R>), if it has one for the T (a batch hook of the impl<Trait, T>, e.g. a vectorized kernel),
+    /// otherwise op(T const&) (or op(Trait const&) through a view the compiler can devirtualize) per element;
+    /// the rest of the segments get op(Trait const&) per element, a virtual call each.
+    template <typename... Ts, typename R, typename Op>
+    void transform(std::span<R> out, Op && op) const {
+        assert(( out.size() >= size() && "transform: out has no room for all the elements" ));
+        using Fn = std::remove_reference_t<Op>;
+        std::size_t position = 0;
+        for (auto const& seg : segments_) {
+            auto const n = seg->size();
+            auto target = out.subspan(position, n);
+            if (not (... || typed_transform<Ts>(*seg, target, op))) {
+                struct { Fn * op; R * out; } state {&op, target.data()};
+                seg->for_each(0, n, (void*)&state, [](void * p, Trait const& item) {
+                    auto & s = *static_cast<decltype(state)*>(p);
+                    *s.out++ = (*s.op)(item);
+                });
+            }
+            position += n;
+        }
+    }
+
+    /// the segments (one per type inserted so far, the emptied ones included), in the order of iteration
+    std::size_t segment_count() const noexcept { return segments_.size(); }
+
+    std::size_t segment_size(std::size_t segment) const noexcept { return segments_[segment]->size(); }
+
+    /// the segment of T, empty if there's none
+    template <typename T>
+    std::span<T> segment() noexcept {
+        auto * seg = find<T>();
+        return seg ? std::span<T>{seg->items} : std::span<T>{};
+    }
+
+    template <typename T>
+    std::span<T const> segment() const noexcept {
+        auto const* seg = find<T>();
+        return seg ? std::span<T const>{seg->items} : std::span<T const>{};
+    }
+
+    iterator begin() noexcept { return {&segments_, 0}; }
+    iterator end() noexcept { return {&segments_, segments_.size()}; }
+    const_iterator begin() const noexcept { return {&segments_, 0}; }
+    const_iterator end() const noexcept { return {&segments_, segments_.size()}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    std::size_t size() const noexcept {
+        std::size_t total = 0;
+        for (auto const& seg : segments_) { total += seg->size(); }
+        return total;
+    }
+
+    template <typename T>
+    std::size_t size() const noexcept { return segment<T>().size(); }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    /// destroys the objects, keeps the segments
+    void clear() noexcept {
+        for (auto & seg : segments_) { seg->clear(); }
+    }
+
+private:
+    template <typename T>
+    typed_segment<T> * find() const noexcept {
+        for (auto const& seg : segments_) {
+            if (seg->key == &detail::type_key<impl<Trait, T>>) { return static_cast<typed_segment<T>*>(seg.get()); }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    typed_segment<T> & segment_for() {
+        if (auto * seg = find<T>()) { return *seg; }
+        auto seg = std::make_unique<typed_segment<T>>();
+        auto & ref = *seg;
+        segments_.push_back(std::move(seg));
+        return ref;
+    }
+
+    template <typename T, typename Seg, typename F>
+    static bool typed_for_each(Seg & seg, std::size_t first, std::size_t last, F & f) {
+        if (seg.key != &detail::type_key<impl<Trait, T>>) { return false; }
+        using Items = std::conditional_t<std::is_const_v<Seg>, typed_segment<T> const, typed_segment<T>>;
+        auto & items = static_cast<Items&>(seg).items;
+        for (std::size_t i = first; i < last; ++i) { f(items[i]); }
+        return true;
+    }
+
+    template <typename T, typename R, typename Op>
+    static bool typed_transform(segment_base const& seg, std::span<R> out, Op & op) {
+        if (seg.key != &detail::type_key<impl<Trait, T>>) { return false; }
+        std::span<T const> items {static_cast<typed_segment<T> const&>(seg).items};
+        if constexpr (std::invocable<Op&, std::span<T const>, std::span<R>>) {
+            op(items, out);
+        } else if constexpr (std::invocable<Op&, T const&>) {
+            for (std::size_t i = 0; i < items.size(); ++i) { out[i] = op(items[i]); }
+        } else {
+            for (std::size_t i = 0; i < items.size(); ++i) { out[i] = op(*some<Trait const&>{items[i]}); }
+        }
+        return true;
+    }
+
+    std::vector<std::unique_ptr<segment_base>> segments_;
+};
+
+} // namespace vx
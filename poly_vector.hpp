@@ -0,0 +1,240 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // max
+#include <cassert>
+#include <cstddef> // byte, size_t
+#include <iterator> // forward_iterator_tag
+#include <limits>
+#include <new> // launder, placement new, align_val_t
+#include <vector>
+
+#include "some.hpp"
+
+namespace vx {
+
+/// ===== [ POLY VECTOR ] =====
+///@brief: A sequence of polymorphic objects of different types, stored contiguously.
+/// Every element is an impl<Trait, T> placed inline into one growable byte buffer (padded to its alignment),
+/// and an offset index keeps track of where each of them starts. Iterating yields Trait&,
+/// walking the buffer front to back instead of chasing pointers to scattered heap blocks.
+///@note: on growth the elements are relocated into the new buffer with `do_action(move_into)`,
+///       so they have to be nothrow move constructible
+///@note: erase leaves a hole in the buffer, which is reclaimed by the next relocation
+///@note: move-only
+template <typename Trait>
+class poly_vector {
+public:
+    using main_trait_t = first_trait_from<Trait>;
+    using value_type = main_trait_t;
+    using reference = main_trait_t&;
+    using const_reference = main_trait_t const&;
+    using size_type = std::size_t;
+
+private:
+    struct slot {
+        std::size_t offset; ///< where the impl<Trait, T> starts in the buffer
+        cfg::SBO footprint; ///< its size and alignment, which is exactly what do_action(move_into) needs to relocate it
+    };
+
+    /// the trait is the primary base of the impl, so it lives at the very start of it (as in the SBO of some<>)
+    template <typename Byte>
+    static auto* at(Byte * base, slot const& s) noexcept {
+        using T = std::conditional_t<std::is_const_v<Byte>, main_trait_t const, main_trait_t>;
+        return std::launder(reinterpret_cast<T*>(base + s.offset));
+    }
+
+    static constexpr std::size_t align_up(std::size_t offset, std::size_t alignment) noexcept {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    template <bool is_const>
+    class basic_iterator {
+        friend class poly_vector;
+        template <bool> friend class basic_iterator;
+
+        using byte_t = std::conditional_t<is_const, std::byte const, std::byte>;
+        using slot_iterator = typename std::vector<slot>::const_iterator;
+
+        basic_iterator(byte_t * base, slot_iterator s) noexcept : base_{base}, slot_{s} {}
+
+        byte_t * base_ = nullptr;
+        slot_iterator slot_{};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = main_trait_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<is_const, main_trait_t const*, main_trait_t*>;
+        using reference = std::conditional_t<is_const, main_trait_t const&, main_trait_t&>;
+
+        basic_iterator() = default;
+
+        operator basic_iterator<true>() const noexcept requires (not is_const) { return {base_, slot_}; }
+
+        reference operator*() const noexcept { return *at(base_, *slot_); }
+        pointer operator->() const noexcept { return at(base_, *slot_); }
+
+        basic_iterator& operator++() noexcept { ++slot_; return *this; }
+        basic_iterator operator++(int) noexcept { auto copy = *this; ++slot_; return copy; }
+
+        bool operator==(basic_iterator const& other) const noexcept { return slot_ == other.slot_; }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    poly_vector() = default;
+
+    poly_vector(poly_vector && other) noexcept
+    : slots_{std::move(other.slots_)}
+    , data_{std::exchange(other.data_, nullptr)}
+    , used_{std::exchange(other.used_, 0)}
+    , capacity_{std::exchange(other.capacity_, 0)}
+    , alignment_{std::exchange(other.alignment_, k_min_alignment)} {
+        other.slots_.clear();
+    }
+
+    poly_vector& operator= (poly_vector && other) noexcept {
+        if (this == &other) { return *this; }
+        clear();
+        deallocate(data_, alignment_);
+        slots_ = std::move(other.slots_);
+        other.slots_.clear();
+        data_ = std::exchange(other.data_, nullptr);
+        used_ = std::exchange(other.used_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        alignment_ = std::exchange(other.alignment_, k_min_alignment);
+        return *this;
+    }
+
+    ~poly_vector() {
+        clear();
+        deallocate(data_, alignment_);
+    }
+
+    /// constructs a T in place at the end of the buffer, relocating everything if it's full
+    ///@returns: the object itself (the pointee, for the pointer-like T)
+    template <typename T, typename... Args>
+    requires (std::constructible_from<T, Args...>)
+    auto& emplace_back(Args&&... args) {
+        using impl_type = vx::impl<Trait, T>;
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "poly_vector relocates its elements, they have to be nothrow move constructible");
+        static_assert(std::is_nothrow_constructible_v<impl_type, T&&>, // the opcode::move_into heap-allocates it otherwise
+                      "poly_vector relocates its elements in place, their impl<Trait, T> has to be nothrow constructible from a T&&");
+        static_assert(sizeof(impl_type) <= std::numeric_limits<u16>::max(), "The object is too big for a poly_vector");
+        constexpr cfg::SBO footprint {sizeof(impl_type), alignof(impl_type)};
+        static_assert(detail::is_sbo_eligible_with<impl_type>(footprint.size, footprint.alignment));
+
+        if (slots_.size() == slots_.capacity()) {
+            slots_.reserve(std::max<std::size_t>(8, 2 * slots_.size())); // so that the push_back below can't throw
+        }
+        std::size_t offset = align_up(used_, footprint.alignment);
+        if (offset + footprint.size > capacity_ || footprint.alignment > alignment_) {
+            relocate(footprint);
+            offset = align_up(used_, footprint.alignment);
+        }
+        auto * p_impl = detail::new_impl<impl_type, T>(data_ + offset, nullptr, std::forward<Args>(args)...);
+        slots_.push_back({offset, footprint});
+        used_ = offset + footprint.size;
+        return p_impl->self();
+    }
+
+    template <typename T>
+    requires (not polymorphic<T>)
+    void push_back(T && obj) {
+        emplace_back<std::remove_cvref_t<T>>(std::forward<T>(obj));
+    }
+
+    /// destroys the element, the ones after it stay where they are in the buffer
+    iterator erase(const_iterator pos) noexcept {
+        auto index = pos.slot_ - slots_.cbegin();
+        at(data_, slots_[index])->~main_trait_t();
+        auto next = slots_.erase(slots_.begin() + index);
+        used_ = slots_.empty() ? 0 : slots_.back().offset + slots_.back().footprint.size;
+        return {data_, next};
+    }
+
+    void clear() noexcept {
+        for (auto const& s : slots_) { at(data_, s)->~main_trait_t(); }
+        slots_.clear();
+        used_ = 0;
+    }
+
+    /// makes sure that `bytes` more bytes of objects fit without relocating
+    void reserve_bytes(std::size_t bytes) {
+        if (used_ + bytes > capacity_) { relocate({0, 1}, bytes); }
+    }
+
+    reference operator[] (size_type index) noexcept { return *at(data_, slots_[index]); }
+    const_reference operator[] (size_type index) const noexcept { return *at(data_, slots_[index]); }
+
+    reference front() noexcept { return *at(data_, slots_.front()); }
+    const_reference front() const noexcept { return *at(data_, slots_.front()); }
+    reference back() noexcept { return *at(data_, slots_.back()); }
+    const_reference back() const noexcept { return *at(data_, slots_.back()); }
+
+    iterator begin() noexcept { return {data_, slots_.cbegin()}; }
+    iterator end() noexcept { return {data_, slots_.cend()}; }
+    const_iterator begin() const noexcept { return {data_, slots_.cbegin()}; }
+    const_iterator end() const noexcept { return {data_, slots_.cend()}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept { return slots_.size(); }
+    bool empty() const noexcept { return slots_.empty(); }
+
+    /// the size of the byte buffer
+    std::size_t capacity_bytes() const noexcept { return capacity_; }
+
+private:
+    static constexpr std::size_t k_min_alignment = alignof(std::max_align_t);
+    static constexpr std::size_t k_min_capacity = 256;
+
+    static std::byte* allocate(std::size_t capacity, std::size_t alignment) {
+        return static_cast<std::byte*>(::operator new(capacity, std::align_val_t{alignment}));
+    }
+
+    static void deallocate(std::byte * data, std::size_t alignment) noexcept {
+        if (data) { ::operator delete(data, std::align_val_t{alignment}); }
+    }
+
+    /// moves the elements into a new buffer that has room for an `incoming` object (and `extra` bytes),
+    /// packing them one after another, so the holes left by erase are gone
+    void relocate(cfg::SBO incoming, std::size_t extra = 0) {
+        std::size_t live = 0;
+        for (auto const& s : slots_) { live = align_up(live, s.footprint.alignment) + s.footprint.size; }
+        std::size_t const needed = align_up(live, incoming.alignment) + incoming.size + extra;
+        std::size_t const capacity = std::max({k_min_capacity, 2 * capacity_, needed + needed / 2});
+        std::size_t const alignment = std::max<std::size_t>(alignment_, incoming.alignment);
+
+        std::byte * fresh = allocate(capacity, alignment);
+        std::size_t cursor = 0;
+        for (auto & s : slots_) {
+            cursor = align_up(cursor, s.footprint.alignment);
+            auto * old = at(data_, s);
+            [[maybe_unused]] auto * moved = old->do_action(detail::opcode::move_into, fresh + cursor, s.footprint);
+            assert(( moved == fresh + cursor && "the impl wasn't moved in place" )); // see the static_asserts of emplace_back
+            old->~main_trait_t();
+            s.offset = cursor;
+            cursor += s.footprint.size;
+        }
+        deallocate(data_, alignment_);
+        data_ = fresh;
+        used_ = cursor;
+        capacity_ = capacity;
+        alignment_ = alignment;
+    }
+
+    std::vector<slot> slots_;
+    std::byte * data_ = nullptr;
+    std::size_t used_ = 0;     ///< the end of the last element
+    std::size_t capacity_ = 0;
+    std::size_t alignment_ = k_min_alignment;
+};
+
+} // namespace vx
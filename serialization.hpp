@@ -0,0 +1,440 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // min, max
+#include <array>
+#include <bit> // bit_cast
+#include <concepts>
+#include <cstddef> // byte, size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <cstring> // memcpy, memmove
+#include <istream>
+#include <memory_resource>
+#include <memory> // destroy_at
+#include <new> // launder
+#include <ostream>
+#include <stdexcept> // runtime_error
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "some.hpp"
+
+namespace vx {
+
+struct serialization_error : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+
+/// ===== [ BINARY STREAMS ] =====
+///@brief: the bytes go straight to (and come straight from) the stream buffer, no formatting, no sentry per call
+class binary_writer {
+public:
+    explicit binary_writer(std::ostream & out) : buffer_{out.rdbuf()} {
+        if (buffer_ == nullptr) { throw serialization_error{"vx::binary_writer: the stream has no buffer"}; }
+    }
+
+    void write_bytes(const void* data, std::size_t size) {
+        auto const n = static_cast<std::streamsize>(size);
+        if (buffer_->sputn(static_cast<const char*>(data), n) != n) {
+            throw serialization_error{"vx::binary_writer: short write"};
+        }
+    }
+
+    template <typename T>
+    void write(T const& value);
+
+private:
+    std::streambuf * buffer_;
+};
+
+class binary_reader {
+public:
+    explicit binary_reader(std::istream & in) : buffer_{in.rdbuf()} {
+        if (buffer_ == nullptr) { throw serialization_error{"vx::binary_reader: the stream has no buffer"}; }
+    }
+
+    void read_bytes(void* data, std::size_t size) {
+        auto const n = static_cast<std::streamsize>(size);
+        if (buffer_->sgetn(static_cast<char*>(data), n) != n) {
+            throw serialization_error{"vx::binary_reader: unexpected end of the stream"};
+        }
+    }
+
+    template <typename T>
+    T read();
+
+    /// the bytes surely left in the stream, 0 if that's unknown (see std::streambuf::in_avail):
+    /// a count read off the stream reserves no more than these can hold
+    std::size_t available() const {
+        auto const n = buffer_->in_avail();
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+private:
+    std::streambuf * buffer_;
+};
+
+
+/// ===== [ SERIALIZER ] =====
+///@brief: how a T is written and read back. The trivially copyable types are block-copied as they are,
+/// specialize it for the others:
+///     template <> struct vx::serializer<Person> {
+///         static void write(vx::binary_writer & out, Person const& p) { out.write(p.name); out.write(p.age); }
+///         static Person read(vx::binary_reader & in) { auto name = in.read<std::string>(); return {name, in.read<int>()}; }
+///     };
+///@note: the bytes are the native representation: the same endianness and layout on both ends, no pointers in the payload
+template <typename T>
+struct serializer {
+    static void write(binary_writer & out, T const& value) requires std::is_trivially_copyable_v<T> {
+        out.write_bytes(&value, sizeof(T));
+    }
+
+    static T read(binary_reader & in) requires std::is_trivially_copyable_v<T> {
+        std::array<std::byte, sizeof(T)> bytes;
+        in.read_bytes(bytes.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+};
+
+/// the size, then the characters
+///@note: read in chunks (the first one as big as the bytes available), so a corrupt size runs into the end of the stream,
+/// not into a huge allocation
+template <typename Char, typename Traits, typename Alloc>
+struct serializer<std::basic_string<Char, Traits, Alloc>> {
+    using string_t = std::basic_string<Char, Traits, Alloc>;
+    static constexpr std::size_t k_chunk = 64 * 1024;
+
+    static void write(binary_writer & out, string_t const& value) {
+        out.write(std::uint64_t{value.size()});
+        out.write_bytes(value.data(), value.size() * sizeof(Char));
+    }
+
+    static string_t read(binary_reader & in) {
+        auto const size = in.read<std::uint64_t>();
+        string_t value;
+        if (size > value.max_size()) { throw serialization_error{"vx::serializer<std::basic_string>: bad size"}; }
+        std::size_t const chunk = std::max(k_chunk, in.available() / sizeof(Char));
+        for (std::size_t done = 0; done < size;) {
+            auto const n = std::min<std::size_t>(chunk, size - done);
+            value.resize(done + n);
+            in.read_bytes(value.data() + done, n * sizeof(Char));
+            done += n;
+        }
+        return value;
+    }
+};
+
+template <typename T>
+concept serializable = requires (binary_writer & out, binary_reader & in, T const& value) {
+    serializer<T>::write(out, value);
+    { serializer<T>::read(in) } -> std::same_as<T>;
+};
+
+template <typename T>
+void binary_writer::write(T const& value) {
+    static_assert(serializable<T>, "Specialize vx::serializer<T> for the types that aren't trivially copyable");
+    serializer<T>::write(*this, value);
+}
+
+template <typename T>
+T binary_reader::read() {
+    static_assert(serializable<T>, "Specialize vx::serializer<T> for the types that aren't trivially copyable");
+    return serializer<T>::read(*this);
+}
+
+
+namespace detail {
+    /// the objects type_registry<Trait> reads into: default constructible empty, then moved into
+    template <typename Object, typename Trait>
+    inline constexpr bool restorable = false;
+
+    template <typename Trait, cfg::some config>
+    inline constexpr bool restorable<some<Trait, config>, Trait> = config.empty_state && config.move;
+
+    template <typename Trait, cfg::fsome config>
+    inline constexpr bool restorable<fsome<Trait, config>, Trait> = config.empty_state && config.move;
+
+    /// the vptr of an impl<Trait, T&>, read off a temporary one bound to a placeholder T that's never read
+    /// (the memmove implicitly creates the T there, the T being trivially copyable)
+    template <typename Trait, typename T>
+    const void* ref_view_vptr_of() noexcept {
+        using view_t = vx::impl<Trait, T&>;
+        static_assert(sizeof(view_t) == sizeof(Trait) + sizeof(void*), "impl<Trait, T&> is expected to hold a T& and nothing else");
+        alignas(T) std::byte placeholder[sizeof(T)] {};
+        T & object = *std::launder(static_cast<T*>(std::memmove(placeholder, placeholder, sizeof(T))));
+        alignas(view_t) std::byte buffer[sizeof(view_t)];
+        auto * view = ::new (static_cast<void*>(buffer)) view_t{object};
+        const void* vptr;
+        std::memcpy(&vptr, buffer, sizeof(vptr));
+        std::destroy_at(view);
+        return vptr;
+    }
+
+    /// converts to the T read off the stream: the constructor of the T's placement takes it and the T returned
+    /// by serializer<T>::read is constructed right there, no T temporary to be moved in
+    template <typename T>
+    struct read_in_place {
+        binary_reader & in;
+        operator T() const { return in.read<T>(); }
+    };
+}// namespace detail
+
+
+/// ===== [ TYPE REGISTRY ] =====
+///@brief: The types that can be saved and restored behind a Trait, each under a stable id of its own,
+/// so that a stream written by one build can be read by another (the ids are the format, the vptrs and the type tokens aren't).
+/// Writes and reads some<Trait> and fsome<Trait> (of any configuration) and the vectors of them:
+/// - an object is its type id (0 for an empty object) followed by its payload, as written by serializer<T>
+/// - a vector is the count of the objects followed by the objects
+/// - on read the T is built right in its final placement, as emplace<T> would place it:
+///   the SBO of the object, or the heap via the object's memory resource (the current arena for a pmr some<>)
+///@note: set it up once (add<T>(id)...), the reads and the writes are const and can run concurrently then
+///@note: the written ids are looked up by the type token of the object (the one impl_cast goes by), the last one is cached
+/// so a run of the same type costs a compare; the read ids below 1024 are an index into a table
+template <typename Trait>
+class type_registry {
+    static_assert(not detail::mixed_traits<Trait>::value, "vx::type_registry is made for a single trait, register the first trait of a mix");
+    static_assert(not std::is_const_v<Trait>, "vx::type_registry<Trait>: the Trait is expected without the const");
+
+public:
+    using type_id = std::uint32_t;
+
+    /// written in place of an empty object, not available for the types
+    static constexpr type_id empty_id = 0;
+
+    ///@brief: registers the T under the id, for both some<Trait> (an impl<Trait, T>) and fsome<Trait> (an impl<Trait, T*>)
+    ///@throws serialization_error: the id is 0, or either the id or the T is registered already
+    template <typename T>
+    type_registry& add(type_id id) {
+        static_assert(serializable<T>, "Specialize vx::serializer<T> for the types that aren't trivially copyable");
+        static_assert(std::is_move_constructible_v<T>, "The restored objects are moved into their placement");
+        if (id == empty_id) { throw serialization_error{"vx::type_registry: the id 0 stands for an empty object"}; }
+        if (readers_.contains(id)) { throw serialization_error{"vx::type_registry: the id is taken"}; }
+        const void* some_token = &detail::type_key<impl<Trait, T>>;
+        const void* fsome_token = &detail::type_key<impl<Trait, T*>>;
+        if (writers_.contains(some_token)) { throw serialization_error{"vx::type_registry: the type is registered already"}; }
+
+        reader_entry const reader {&read_some_as<T>, &read_fsome_as<T>};
+        readers_.emplace(id, reader);
+        if (id < k_dense_ids) {
+            if (dense_readers_.size() <= id) { dense_readers_.resize(id + 1, reader_entry{}); }
+            dense_readers_[id] = reader;
+        }
+        writers_.emplace(some_token, writer_entry{some_token, id, &write_as<impl<Trait, T>>, &payload_of<impl<Trait, T>>});
+        writers_.emplace(fsome_token, writer_entry{fsome_token, id, &write_as<impl<Trait, T*>>, &payload_of<impl<Trait, T*>>});
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            views_.emplace(id, view_entry{detail::ref_view_vptr_of<Trait, T>(), sizeof(T), alignof(T)});
+        }
+        return *this;
+    }
+
+    bool contains(type_id id) const noexcept { return readers_.contains(id); }
+
+    std::size_t size() const noexcept { return readers_.size(); }
+
+    ///@brief: the id the object is written under, empty_id for an empty object
+    ///@throws serialization_error: the type of the object isn't registered
+    template <typename Object>
+    type_id id_of(Object const& object) const {
+        auto const* p = object_of(object);
+        return p ? find_writer(p->type_token()).id : empty_id;
+    }
+
+    template <typename Object>
+    void write(binary_writer & out, Object const& object) const {
+        writer_entry const* last = nullptr;
+        write_object(out, object_of(object), last);
+    }
+
+    template <typename Object, typename Alloc>
+    void write(binary_writer & out, std::vector<Object, Alloc> const& objects) const {
+        out.write(std::uint64_t{objects.size()});
+        writer_entry const* last = nullptr;
+        for (auto const& object : objects) {
+            write_object(out, object_of(object), last);
+        }
+    }
+
+    ///@brief: restores an object written by write(), e.g. `auto shape = registry.read<vx::some<Shape>>(in);`
+    ///@throws serialization_error: an unknown type id, or the stream is cut short
+    template <typename Object>
+    Object read(binary_reader & in) const {
+        static_assert(detail::restorable<Object, Trait>, "Objects are read into some<Trait> and fsome<Trait>");
+        Object object;
+        read_object(in, object);
+        return object;
+    }
+
+    ///@brief: appends the objects written by write(vector) to the `objects`
+    /// (in place, so a std::pmr::vector of pmr some<>s hands its resource over to them)
+    ///@note: the objects read so far are kept on an error
+    template <typename Object, typename Alloc>
+    void read(binary_reader & in, std::vector<Object, Alloc> & objects) const {
+        static_assert(detail::restorable<Object, Trait>, "Objects are read into some<Trait> and fsome<Trait>");
+        auto const count = in.read<std::uint64_t>();
+        if (count > objects.max_size() - objects.size()) { throw serialization_error{"vx::type_registry: bad object count"}; }
+        // an object takes at least its type id: a corrupt count grows the vector as the objects come in, not up front
+        auto const room = std::max<std::size_t>(k_min_reserve, in.available() / sizeof(type_id));
+        objects.reserve(objects.size() + std::min(static_cast<std::size_t>(count), room));
+        for (std::uint64_t i = 0; i < count; ++i) {
+            auto & object = objects.emplace_back();
+            try {
+                read_object(in, object);
+            } catch (...) {
+                objects.pop_back();
+                throw;
+            }
+        }
+    }
+
+private:
+    using write_fn = void (*)(binary_writer &, Trait const*);
+
+    template <typename> friend class mapped_store;
+
+    struct writer_entry {
+        const void* token;
+        type_id id;
+        write_fn write;
+        const void* (*payload)(Trait const*); ///< the address of the T
+    };
+
+    /// the trivially copyable types, as a mapped_store sees them
+    struct view_entry {
+        const void* vptr; ///< of the impl<Trait, T&>
+        std::uint32_t size;
+        std::uint32_t alignment;
+    };
+
+    /// where the object read goes: the SBO and the memory resource of the some<>/fsome<> it's read into
+    struct destination {
+        void* sbo_buffer;
+        cfg::SBO sbo;
+        std::pmr::memory_resource * mr;
+        detail::placement placed; ///< the some<>'s (see storage_for::reset)
+        bool trivial_payload = false; ///< out
+    };
+
+    /// the T read right into its placement: an impl<Trait, T> for a some<>, a T and an impl<Trait, T*> at the `iface` for an fsome<>
+    struct reader_entry {
+        Trait* (*some)(binary_reader &, destination &) = nullptr;
+        void (*fsome)(binary_reader &, destination &, void* iface) = nullptr;
+    };
+
+    template <cfg::some config>
+    static Trait const* object_of(some<Trait, config> const& object) noexcept { return object.storage.get(); }
+
+    template <cfg::fsome config>
+    static Trait const* object_of(fsome<Trait, config> const& object) {
+        return object.vptr() ? object.trait_ptr() : nullptr;
+    }
+
+    writer_entry const& find_writer(const void* token) const {
+        auto it = writers_.find(token);
+        if (it == writers_.end()) { throw serialization_error{"vx::type_registry: the type isn't registered"}; }
+        return it->second;
+    }
+
+    /// the writer of the object's type, the `last` one if it's the same type
+    writer_entry const& writer_of(Trait const* object, writer_entry const* last) const {
+        const void* token = object->type_token();
+        return (last != nullptr && last->token == token) ? *last : find_writer(token);
+    }
+
+    void write_object(binary_writer & out, Trait const* object, writer_entry const*& last) const {
+        if (object == nullptr) {
+            out.write(empty_id);
+            return;
+        }
+        last = &writer_of(object, last);
+        out.write(last->id);
+        last->write(out, object);
+    }
+
+    template <typename Object>
+    void read_object(binary_reader & in, Object & object) const {
+        auto const id = in.read<type_id>();
+        if (id == empty_id) { return; }
+        read_into(in, object, find_reader(id));
+    }
+
+    reader_entry const& find_reader(type_id id) const {
+        if (id < dense_readers_.size()) {
+            if (auto const& read = dense_readers_[id]; read.some) { return read; }
+        } else if (auto it = readers_.find(id); it != readers_.end()) {
+            return it->second;
+        }
+        throw serialization_error{"vx::type_registry: unknown type id"};
+    }
+
+    template <typename Impl>
+    static void write_as(binary_writer & out, Trait const* object) {
+        out.write(static_cast<Impl const*>(object)->self());
+    }
+
+    template <typename Impl>
+    static const void* payload_of(Trait const* object) {
+        return &static_cast<Impl const*>(object)->self();
+    }
+
+    /// the impl<Trait, T> built where storage_for::emplace<T> builds it, the `placed` (in) tells about the relocatable layout
+    template <typename T>
+    static Trait* read_some_as(binary_reader & in, destination & to) {
+        using impl_t = impl<Trait, T>;
+        constexpr bool relocatable = vx::is_trivially_relocatable_v<T>;
+        bool const in_sbo = detail::is_sbo_eligible_with<impl_t>(to.sbo.size, to.sbo.alignment)
+                            && (relocatable || not to.placed.relocatable_only);
+        auto * object = detail::new_impl<impl_t, T>(in_sbo ? to.sbo_buffer : nullptr, to.mr, detail::read_in_place<T>{in});
+        to.placed.relocatable = relocatable;
+        to.trivial_payload = std::is_trivially_destructible_v<T>;
+        return object;
+    }
+
+    /// the T placed where fsome_storage_policy::make_in_place places it, the impl<Trait, T*> pointing to it at the `iface`
+    template <typename T>
+    static void read_fsome_as(binary_reader & in, destination & to, void* iface) {
+        bool const in_sbo = detail::is_sbo_eligible_with<T>(to.sbo.size, to.sbo.alignment);
+        T * object = in_sbo ? ::new(to.sbo_buffer) T(detail::read_in_place<T>{in})
+                            : detail::fsome_heap<Trait, T>::make(to.mr, detail::read_in_place<T>{in});
+        ::new(iface) impl<Trait, T*>(object);
+        to.trivial_payload = std::is_trivially_destructible_v<T>;
+        if constexpr (vx::is_trivially_relocatable_v<T>) {
+            if (in_sbo) { detail::remember_relocatable<Trait*, impl<Trait, T*>>(iface); } // as fsome::remember_if_relocatable
+        }
+    }
+
+    template <cfg::some config>
+    static void read_into(binary_reader & in, some<Trait, config> & target, reader_entry const& reader) {
+        auto & storage = target.storage;
+        destination to {storage.sbo_buffer(), storage.sbo(), storage.resource(), storage.placement()};
+        auto * object = reader.some(in, to);
+        storage.reset(object, to.placed);
+        storage.mark_trivial_payload(to.trivial_payload);
+    }
+
+    template <cfg::fsome config>
+    static void read_into(binary_reader & in, fsome<Trait, config> & target, reader_entry const& reader) {
+        destination to {target.get_sbo_buffer(), config.sbo, target.resource(), {}};
+        reader.fsome(in, to, (void*)&target.poly_.iface);
+        target.mark_trivial_payload(to.trivial_payload);
+    }
+
+    /// the small ids are looked up by the index
+    static constexpr type_id k_dense_ids = 1024;
+
+    /// the objects a vector reserves for up front whatever the bytes available (see binary_reader::available)
+    static constexpr std::size_t k_min_reserve = 1024;
+
+    std::unordered_map<type_id, reader_entry> readers_;
+    std::vector<reader_entry> dense_readers_;
+    std::unordered_map<const void*, writer_entry> writers_;
+    std::unordered_map<type_id, view_entry> views_;
+};
+
+} // namespace vx
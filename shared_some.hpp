@@ -0,0 +1,178 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef> // size_t, nullptr_t
+#include <type_traits>
+#include <utility> // exchange, forward, move, swap
+
+#include "some.hpp"
+
+namespace vx {
+
+template <typename Trait>
+class weak_some;
+
+/// ===== [ SHARED SOME ] =====
+///@brief: A shared, immutable polymorphic object: copying a shared_some bumps a reference count instead of cloning the object.
+/// The reference counts live in front of the impl<Trait, T> in a single allocation (as with std::make_shared),
+/// so that's one allocation per object and two pointers per shared_some (the counts and the object).
+/// The object is only ever accessed through a `Trait const`, only the const methods of the trait can be called,
+/// and so it can be passed across threads as long as those are thread-safe (the counts are atomic).
+///@note: a shared_some made from an rvalue some<> moves the object into a new shared block (one allocation + a move),
+///       the some<> is left empty
+template <typename Trait>
+class shared_some {
+    template <typename> friend class shared_some;
+    friend class weak_some<Trait>;
+    friend class cow_some<Trait>;
+
+    using main_trait_t = first_trait_from<Trait>;
+
+public:
+    template <typename X>
+    using impl_type = vx::impl< Trait, std::remove_cvref_t<X> >;
+
+    shared_some() noexcept = default;
+
+    shared_some(std::nullptr_t) noexcept {}
+
+    template <typename T>
+    requires (not polymorphic<T> && not std::is_same_v<std::remove_cvref_t<T>, shared_some>)
+    shared_some(T && obj) {
+        auto * block = new detail::shared_block< impl_type<T> >(std::forward<T>(obj));
+        header_ = block;
+        object_ = &block->object;
+    }
+
+    /// takes over the object of the `other` (moved into a new shared block), leaving the `other` empty
+    template <cfg::some config>
+    requires (config.move || config.copy)
+    explicit shared_some(some<Trait, config> && other) {
+        auto & storage = other.storage;
+        if (storage.get() == nullptr) { return; }
+        object_ = static_cast<main_trait_t const*>(
+            storage.get()->do_action(detail::opcode::share_into, nullptr, {}, &header_, nullptr));
+        storage.clear();
+    }
+
+    shared_some(shared_some const& other) noexcept : header_{other.header_}, object_{other.object_} {
+        if (header_) { header_->strong.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    shared_some(shared_some && other) noexcept
+    : header_{std::exchange(other.header_, nullptr)}, object_{std::exchange(other.object_, nullptr)} {}
+
+    shared_some& operator= (shared_some other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~shared_some() { release(); }
+
+    void reset() noexcept { shared_some{}.swap(*this); }
+
+    void swap(shared_some & other) noexcept {
+        std::swap(header_, other.header_);
+        std::swap(object_, other.object_);
+    }
+
+    main_trait_t const* operator-> () const noexcept { return object_; }
+
+    main_trait_t const& operator* () const noexcept { return *object_; }
+
+    template <typename Target>
+    const Target* try_get() const noexcept {
+        auto * impl = detail::impl_cast<impl_type<Target> const>(object_);
+        return impl ? &impl->self() : nullptr;
+    }
+
+    /// the number of shared_somes sharing the object (0 for an empty one)
+    std::size_t use_count() const noexcept {
+        return header_ ? header_->strong.load(std::memory_order_relaxed) : 0;
+    }
+
+    explicit operator bool() const noexcept { return object_ != nullptr; }
+
+    bool operator== (shared_some const& other) const noexcept { return object_ == other.object_; }
+
+private:
+    /// takes over an already counted reference
+    shared_some(detail::shared_header * header, main_trait_t const* object) noexcept : header_{header}, object_{object} {}
+
+    void release() noexcept {
+        if (not header_) { return; }
+        if (header_->strong.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            header_->manage(header_, false);
+            release_weak(header_);
+        }
+    }
+
+    static void release_weak(detail::shared_header * header) noexcept {
+        if (header->weak.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            header->manage(header, true);
+        }
+    }
+
+    detail::shared_header * header_ = nullptr;
+    main_trait_t const* object_ = nullptr;
+};
+
+
+/// ===== [ WEAK SOME ] =====
+///@brief: A non-owning observer of a shared_some's object, lock() it to access the object.
+/// Keeps the allocation (but not the object) alive.
+template <typename Trait>
+class weak_some {
+    using main_trait_t = first_trait_from<Trait>;
+
+public:
+    weak_some() noexcept = default;
+
+    weak_some(shared_some<Trait> const& shared) noexcept : header_{shared.header_}, object_{shared.object_} {
+        if (header_) { header_->weak.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    weak_some(weak_some const& other) noexcept : header_{other.header_}, object_{other.object_} {
+        if (header_) { header_->weak.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    weak_some(weak_some && other) noexcept
+    : header_{std::exchange(other.header_, nullptr)}, object_{std::exchange(other.object_, nullptr)} {}
+
+    weak_some& operator= (weak_some other) noexcept {
+        std::swap(header_, other.header_);
+        std::swap(object_, other.object_);
+        return *this;
+    }
+
+    ~weak_some() {
+        if (header_) { shared_some<Trait>::release_weak(header_); }
+    }
+
+    /// a shared_some of the object, or an empty one if the object is already gone
+    shared_some<Trait> lock() const noexcept {
+        if (not header_) { return {}; }
+        std::size_t count = header_->strong.load(std::memory_order_relaxed);
+        while (count != 0) {
+            if (header_->strong.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return {header_, object_};
+            }
+        }
+        return {};
+    }
+
+    bool expired() const noexcept { return use_count() == 0; }
+
+    std::size_t use_count() const noexcept {
+        return header_ ? header_->strong.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    detail::shared_header * header_ = nullptr;
+    main_trait_t const* object_ = nullptr;
+};
+
+} // namespace vx
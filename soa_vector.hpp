@@ -0,0 +1,314 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // count, find, max
+#include <bit> // bit_cast
+#include <cstddef> // byte, size_t
+#include <cstring> // memcpy
+#include <iterator> // forward_iterator_tag
+#include <memory> // unique_ptr
+#include <new> // launder, placement new
+#include <span>
+#include <stdexcept> // out_of_range
+#include <type_traits>
+#include <utility> // exchange, forward
+#include <vector>
+
+#include "some.hpp"
+
+namespace vx {
+
+/// ===== [ SOA VECTOR ] =====
+///@brief: A sequence of fsome<Trait, config>s taken apart (structure of arrays): the vptrs of the impl<Trait, T*>s
+/// in one array, the data pointers in another one, and (with the SBO) the inline slots the data pointers point into in a third.
+/// `soa[i]` puts the {vptr, dptr} pair back together into a handle that is exactly what an fsome keeps inline,
+/// so the calls through it are the calls of an fsome: one indirect call, no extra indirection.
+/// The type scans (`count<T>()`, `find<T>()`, `for_each<T>()`, or anything over `vptrs()`) read the vptr array only:
+/// 8 bytes per element instead of the 16 of the {vptr, dptr} pairs, and the objects of the other types aren't touched.
+///@note: only the trivially relocatable objects go into the slots (they are memcpy'd along when the slots grow),
+///       the rest is on the heap; the data pointers into the slots are fixed up on growth
+///@note: the handles are views, invalidated by the growth (the slots) and by the removal of their element
+///@note: the handle of an empty element (an empty fsome pushed in) is not to be called, see vptrs()
+///@note: move-only, no memory resources
+template <typename Trait, cfg::fsome config = cfg::fsome{}>
+class soa_vector {
+    static_assert(not config.pmr, "vx::soa_vector: the memory resources are not supported");
+
+    using raw_trait_t = std::remove_cv_t<Trait>;
+
+    /// the impl<Trait, T*> that fsome keeps inline (see some_ptr): a vptr and a data pointer
+    struct layout {
+        const void* vptr;
+        void* dptr;
+    };
+
+    static constexpr bool has_slots = config.sbo.size > 0;
+
+    struct slot {
+        alignas(config.sbo.alignment) std::byte bytes[has_slots ? config.sbo.size : 1];
+    };
+
+    template <typename X>
+    static constexpr bool in_slot = has_slots && detail::is_sbo_eligible_with<X>(config.sbo.size, config.sbo.alignment)
+                                              && is_trivially_relocatable_v<X>;
+
+public:
+    using size_type = std::size_t;
+
+    ///@brief: an fsome-compatible view of an element: the impl<Trait, T*> put back together out of the vptr and the data pointer
+    template <typename Qualified>
+    class handle : public basic_operations_for<handle<Qualified>, raw_trait_t> {
+        friend class soa_vector;
+        friend struct basic_operations_for<handle<Qualified>, raw_trait_t>;
+
+        handle(const void* vptr, void* dptr) noexcept {
+            layout bits {vptr, dptr};
+            std::memcpy(&iface, &bits, sizeof(bits));
+        }
+
+        std::add_pointer_t<Qualified> trait_ptr() noexcept {
+            return std::launder(reinterpret_cast<std::add_pointer_t<Qualified>>(&iface));
+        }
+
+        std::add_pointer_t<const raw_trait_t> trait_ptr() const noexcept {
+            return std::launder(reinterpret_cast<std::add_pointer_t<const raw_trait_t>>(&iface));
+        }
+
+        static_assert(sizeof(raw_trait_t) + sizeof(void*) == sizeof(layout), "the Trait is expected to have no data");
+        alignas(raw_trait_t) std::byte iface[sizeof(layout)];
+
+    public:
+        template <typename X>
+        using impl_type = impl<raw_trait_t, X*>;
+
+        /// as fsome::vptr(), nullptr for an empty element
+        const void* vptr() const noexcept { return std::bit_cast<layout>(iface).vptr; }
+
+        /// as fsome::data(): the address of the object (in its slot or on the heap)
+        const void* data() const noexcept { return std::bit_cast<layout>(iface).dptr; }
+    };
+
+    using reference = handle<raw_trait_t>;
+    using const_reference = handle<raw_trait_t const>;
+
+private:
+    template <bool is_const>
+    class basic_iterator {
+        friend class soa_vector;
+        using owner_t = std::conditional_t<is_const, soa_vector const, soa_vector>;
+
+        basic_iterator(owner_t * owner, size_type index) noexcept : owner_{owner}, index_{index} {}
+
+        owner_t * owner_ = nullptr;
+        size_type index_ = 0;
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag; ///< yields the handles by value
+        using value_type = std::conditional_t<is_const, const_reference, reference>;
+        using difference_type = std::ptrdiff_t;
+
+        basic_iterator() = default;
+
+        operator basic_iterator<true>() const noexcept requires (not is_const) { return {owner_, index_}; }
+
+        value_type operator*() const noexcept { return (*owner_)[index_]; }
+
+        basic_iterator& operator++() noexcept { ++index_; return *this; }
+        basic_iterator operator++(int) noexcept { auto copy = *this; ++index_; return copy; }
+
+        bool operator==(basic_iterator const& other) const noexcept { return index_ == other.index_; }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    soa_vector() = default;
+
+    soa_vector(soa_vector && other) noexcept
+    : vptrs_{std::move(other.vptrs_)}
+    , dptrs_{std::move(other.dptrs_)}
+    , slots_{std::move(other.slots_)}
+    , capacity_{std::exchange(other.capacity_, 0)} {
+        other.vptrs_.clear();
+        other.dptrs_.clear();
+    }
+
+    soa_vector& operator= (soa_vector && other) noexcept {
+        if (this == &other) { return *this; }
+        clear();
+        vptrs_ = std::move(other.vptrs_);
+        dptrs_ = std::move(other.dptrs_);
+        slots_ = std::move(other.slots_);
+        capacity_ = std::exchange(other.capacity_, 0);
+        other.vptrs_.clear();
+        other.dptrs_.clear();
+        return *this;
+    }
+
+    ~soa_vector() { clear(); }
+
+    /// the vptr the elements of type T have, the same as the fsome<Trait>::vptr() of a T
+    template <typename T>
+    static const void* vptr_of() noexcept {
+        static const void* const vptr = [] {
+            using impl_type = impl<raw_trait_t, T*>;
+            alignas(impl_type) std::byte buffer[sizeof(impl_type)];
+            auto * object = ::new(buffer) impl_type{static_cast<T*>(nullptr)};
+            const void* result = detail::vptr_of(object);
+            object->~impl_type();
+            return result;
+        }();
+        return vptr;
+    }
+
+    /// constructs a T in place at the end: in its slot if it fits there (and is trivially relocatable), on the heap otherwise
+    template <typename T, typename... Args>
+    requires (not polymorphic<T> && std::is_constructible_v<T, Args&&...>)
+    T& emplace_back(Args&&... args) {
+        static_assert(sizeof(impl<raw_trait_t, T*>) == sizeof(layout));
+        if (size() == capacity_) { reserve(std::max<size_type>(16, 2 * capacity_)); }
+        T * object;
+        if constexpr (in_slot<T>) {
+            object = ::new(&slots_[size()]) T(std::forward<Args>(args)...);
+        } else {
+            object = detail::fsome_heap<raw_trait_t, T>::make(nullptr, std::forward<Args>(args)...); // as fsome<> places it
+        }
+        vptrs_.push_back(vptr_of<T>()); // reserved, can't throw
+        dptrs_.push_back(object);
+        return *object;
+    }
+
+    template <typename T>
+    requires (not polymorphic<T>)
+    void push_back(T && obj) {
+        emplace_back<std::remove_cvref_t<T>>(std::forward<T>(obj));
+    }
+
+    /// takes over the object of the fsome, which is left empty: a heap-resident object is handed over as is,
+    /// an SBO-resident one is moved into the slot (or onto the heap); an empty fsome makes an empty element
+    template <cfg::fsome other_config>
+    requires (not other_config.pmr)
+    void push_back(fsome<Trait, other_config> && other) {
+        if (size() == capacity_) { reserve(std::max<size_type>(16, 2 * capacity_)); }
+        layout bits {other.vptr(), const_cast<void*>(other.data())};
+        if (bits.vptr != nullptr && other.data() == other.get_sbo_buffer()) {
+            cfg::SBO const sbo = has_slots && other.payload_relocatable() ? config.sbo : cfg::SBO{0, config.sbo.alignment};
+            alignas(raw_trait_t) std::byte iface[sizeof(layout)];
+            other->do_action(detail::opcode::fsome_move_sbo_into, slot_at(size()), sbo, (void*)iface);
+            bits = std::bit_cast<layout>(iface);
+            other.clear();
+        }
+        other.poly_.forget();
+        vptrs_.push_back(bits.vptr);
+        dptrs_.push_back(bits.dptr);
+    }
+
+    void pop_back() noexcept {
+        destroy(size() - 1);
+        vptrs_.pop_back();
+        dptrs_.pop_back();
+    }
+
+    void clear() noexcept {
+        for (size_type i = 0; i < size(); ++i) { destroy(i); }
+        vptrs_.clear();
+        dptrs_.clear();
+    }
+
+    /// room for `n` elements: the slots are moved to the new array (memcpy) and the data pointers into them fixed up
+    void reserve(size_type n) {
+        if (n <= capacity_) { return; }
+        vptrs_.reserve(n);
+        dptrs_.reserve(n);
+        if constexpr (has_slots) {
+            auto fresh = std::make_unique_for_overwrite<slot[]>(n);
+            if (size() > 0) { std::memcpy(fresh.get(), slots_.get(), size() * sizeof(slot)); }
+            for (size_type i = 0; i < size(); ++i) {
+                if (dptrs_[i] == &slots_[i]) { dptrs_[i] = &fresh[i]; }
+            }
+            slots_ = std::move(fresh);
+        }
+        capacity_ = n;
+    }
+
+    reference operator[] (size_type index) noexcept { return {vptrs_[index], dptrs_[index]}; }
+    const_reference operator[] (size_type index) const noexcept { return {vptrs_[index], dptrs_[index]}; }
+
+    reference at(size_type index) {
+        if (index >= size()) { throw std::out_of_range{"vx::soa_vector::at"}; }
+        return (*this)[index];
+    }
+
+    const_reference at(size_type index) const {
+        if (index >= size()) { throw std::out_of_range{"vx::soa_vector::at"}; }
+        return (*this)[index];
+    }
+
+    iterator begin() noexcept { return {this, 0}; }
+    iterator end() noexcept { return {this, size()}; }
+    const_iterator begin() const noexcept { return {this, 0}; }
+    const_iterator end() const noexcept { return {this, size()}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept { return vptrs_.size(); }
+    bool empty() const noexcept { return vptrs_.empty(); }
+    size_type capacity() const noexcept { return capacity_; }
+
+    /// ===== [ vptr-only scans ] =====
+
+    /// the vptrs of the elements (see vptr_of), nullptr for the empty ones
+    std::span<const void* const> vptrs() const noexcept { return vptrs_; }
+
+    template <typename T>
+    size_type count() const noexcept {
+        return static_cast<size_type>(std::count(vptrs_.begin(), vptrs_.end(), vptr_of<T>()));
+    }
+
+    /// the index of the first T at or after `from`, size() if there's none
+    template <typename T>
+    size_type find(size_type from = 0) const noexcept {
+        auto const first = vptrs_.begin() + static_cast<std::ptrdiff_t>(std::min(from, size()));
+        return static_cast<size_type>(std::find(first, vptrs_.end(), vptr_of<T>()) - vptrs_.begin());
+    }
+
+    /// f(T&) for the elements of type T, with no virtual call: only those are touched
+    template <typename T, typename F>
+    void for_each(F && f) {
+        auto const vptr = vptr_of<T>();
+        for (size_type i = 0; i < size(); ++i) {
+            if (vptrs_[i] == vptr) { f(*static_cast<T*>(dptrs_[i])); }
+        }
+    }
+
+    template <typename T, typename F>
+    void for_each(F && f) const {
+        auto const vptr = vptr_of<T>();
+        for (size_type i = 0; i < size(); ++i) {
+            if (vptrs_[i] == vptr) { f(*static_cast<T const*>(dptrs_[i])); }
+        }
+    }
+
+private:
+    void * slot_at(size_type index) noexcept {
+        if constexpr (has_slots) { return &slots_[index]; } else { return nullptr; }
+    }
+
+    /// the fsome cleanup: in place if the data pointer is the slot, from the heap otherwise
+    void destroy(size_type index) noexcept {
+        if (vptrs_[index] == nullptr) { return; }
+        reference object {vptrs_[index], dptrs_[index]};
+        object->do_action(detail::opcode::cleanup, slot_at(index), config.sbo);
+    }
+
+    std::vector<const void*> vptrs_;
+    std::vector<void*> dptrs_;
+    std::unique_ptr<slot[]> slots_; ///< one per element, capacity_ of them
+    size_type capacity_ = 0;
+};
+
+} // namespace vx
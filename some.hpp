@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include <atomic> // the cached vptrs of try_get
+#include <bit> // bit_cast, bit_width, has_single_bit
+#include <cassert>
 #include <concepts>
+#include <cstddef> // max_align_t, byte
 #include <cstdint> //ints
 #include <cstring> //memcpy
 #include <iostream>
 #include <memory> // unique_ptr
+#include <memory_resource> // pmr::memory_resource, pmr::polymorphic_allocator
+#include <new> // launder, placement new
+#include <stdexcept> // runtime_error
 #include <type_traits>
 #include <utility> // forward, move, exchange
 
@@ -56,6 +63,9 @@ struct some {
     bool move {true};
     bool empty_state {true};
     bool check_empty {VX_HARDENED};
+    bool pmr {false}; ///< heap placements go through a std::pmr::memory_resource* held by the object
+    bool relocatable {false}; ///< SBO residency is a tag, not a pointer into the some<> itself, so that the some<> can be memcpy'd
+                              ///< (only the trivially relocatable objects are placed into the SBO then)
 };
 
 struct fsome {
@@ -64,6 +74,7 @@ struct fsome {
     bool move {true};
     bool empty_state {true};
     bool check_empty {VX_HARDENED};
+    bool pmr {false}; ///< heap placements go through a std::pmr::memory_resource* held by the object
 };
 }// namespace cfg
 
@@ -80,9 +91,27 @@ struct some;
 template <typename Trait, cfg::fsome>
 struct fsome;
 
-template <typename Trait, std::size_t SBO_capacity, std::size_t alignment>
+template <typename Trait, std::size_t SBO_capacity, std::size_t alignment, bool pmr=false, bool relocatable_layout=false>
 struct storage_for;
 
+template <typename Trait>
+class poly_vector;
+
+template <typename Trait>
+class shared_some;
+
+template <typename Trait>
+class cow_some;
+
+template <typename Trait>
+class type_registry;
+
+template <typename Trait>
+class mapped_store;
+
+template <typename Trait, cfg::fsome config>
+class soa_vector;
+
 namespace detail {
     template <typename> struct is_polymorphic : std::false_type {};
     
@@ -161,6 +190,14 @@ namespace detail {
     template <typename>
     struct mixed_traits : std::false_type {};
 
+    /// the position of T in the Ts..., sizeof...(Ts) if it's not there
+    template <typename T, typename... Ts>
+    constexpr std::size_t index_in = [] {
+        std::size_t index = 0;
+        ((std::is_same_v<T, Ts> ? false : (++index, true)) && ...);
+        return index;
+    }();
+
     template <typename... Ts>
     struct mixed_traits<vx::mix<Ts...>> : std::true_type {};
 
@@ -178,16 +215,84 @@ namespace detail {
         copy_into,
         move_into,
         fsome_move_sbo_into,
+        hand_over_block,
 #if not VX_FSOME_ELIDE_VCALL_ON_MOVE
         fsome_move_ptr_into,
 #endif
-        cleanup
+        cleanup,
+        dispose,
+        share_into,
+        share_copy_into,
+        view_into
+    };
+
+    /// placement: the `extra` of a copy_into/move_into into a some<>'s storage (or null),
+    /// tells the storage what it got, since the storage doesn't know the type
+    struct placement {
+        bool relocatable_only = false; ///< in: only a trivially relocatable object may go into the SBO (the relocatable layout)
+        bool relocatable = false;      ///< out: the object is trivially relocatable
     };
 }//namespace detail
 
 template <typename T>
 using first_trait_from = typename detail::extract_first_trait_from<T>::type;
 
+namespace detail {
+    /// trait narrowing: an object of the `From` trait(s) can be owned as a `To`, the `To` being the first trait of the mix,
+    /// or a base of it (or of the non-mixed `From`)
+    ///@note: the `To` is expected at the very start of the object (the SBO residency and the copies rely on that),
+    ///       which is the case for the first trait of a mix and for the single inheritance
+    template <typename From, typename To>
+    concept narrows_to = not std::is_same_v<From, To> 
+                         && not mixed_traits<To>::value 
+                         && std::is_base_of_v<To, first_trait_from<From>>;
+}// namespace detail
+
+
+/// ===== [ ARENA ] =====
+///@brief: A request-scoped monotonic memory resource.
+/// While an arena is alive, it's the default resource of the pmr some/fsome (.pmr=true) created on this thread:
+/// their heap placements are bump-allocated and given back all at once when the arena goes out of scope.
+/// Deallocation is a no-op, and the objects holding a trivially destructible payload skip their cleanup altogether.
+///@note: the arenas nest (LIFO), the innermost one is current
+///@note: the objects allocated from an arena must not outlive it
+class arena final : public std::pmr::memory_resource {
+public:
+    explicit arena(std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
+    : pool_{upstream} {}
+
+    explicit arena(std::size_t initial_size, std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
+    : pool_{initial_size, upstream} {}
+
+    /// starts off with the user-provided buffer (e.g. on the stack), goes upstream once it runs out
+    arena(void * buffer, std::size_t size, std::pmr::memory_resource * upstream = std::pmr::get_default_resource())
+    : pool_{buffer, size, upstream} {}
+
+    arena(arena const&) = delete;
+    arena& operator= (arena const&) = delete;
+
+    ~arena() { current_ = previous_; }
+
+    /// the innermost arena alive on this thread, if any
+    static arena * current() noexcept { return current_; }
+
+    static std::pmr::memory_resource * current_or_default() noexcept {
+        return current_ ? current_ : std::pmr::get_default_resource();
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override { return pool_.allocate(bytes, alignment); }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {} // released in bulk
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+
+    std::pmr::monotonic_buffer_resource pool_;
+    arena * previous_ = std::exchange(current_, this);
+
+    static inline thread_local arena * current_ = nullptr;
+};
+
 
 namespace detail {
 /// is_sbo_eligible_with<X>:
@@ -200,6 +305,147 @@ constexpr bool is_sbo_eligible_with(u16 SBO_capacity, u16 SBO_alignment) {
         && (not std::is_move_constructible_v<T> || std::is_nothrow_move_constructible_v<T>);
 }
 
+
+/// ===== [ Heap placement ] =====
+/// @note a null memory resource stands for the global new/delete, 
+///       which is what every non-pmr some/fsome uses
+
+/// heap_new: allocates and constructs an X, either with the global new or from the memory resource
+template <typename X, typename... Args>
+X* heap_new(std::pmr::memory_resource * mr, Args&&... args) {
+    if (not mr) { return new X(std::forward<Args>(args)...); }
+    void * p = mr->allocate(sizeof(X), alignof(X));
+    try {
+        return new(p) X(std::forward<Args>(args)...);
+    } catch (...) {
+        mr->deallocate(p, sizeof(X), alignof(X));
+        throw;
+    }
+}
+
+/// heap_delete: the counterpart of heap_new, X has to be the exact type the object was created with
+template <typename X>
+void heap_delete(std::pmr::memory_resource * mr, X * p) noexcept {
+    if (not mr) { delete p; return; }
+    p->~X();
+    mr->deallocate(p, sizeof(X), alignof(X));
+}
+
+/// new_impl: an Impl (an impl<Trait, T>) out of the T's constructor arguments, in the `buffer` or on the heap if it's null.
+/// The T is constructed in place: right off a T argument, or through the in_place constructor of impl_for
+/// (direct-initialized, so a T-convertible argument is converted right there), the impl that doesn't pull
+/// the impl_for constructors in gets a T moved in
+template <typename Impl, typename T, typename... Args>
+Impl* new_impl(void * buffer, std::pmr::memory_resource * mr, Args&&... args) {
+    auto construct = [&](auto&&... xs) -> Impl* {
+        if (buffer) { return ::new(buffer) Impl(std::forward<decltype(xs)>(xs)...); }
+        return heap_new<Impl>(mr, std::forward<decltype(xs)>(xs)...);
+    };
+    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...)) {
+        return construct(std::forward<Args>(args)...);
+    } else if constexpr (sizeof...(Args) == 1 && (std::convertible_to<Args&&, T> && ...)
+                         && not std::is_constructible_v<Impl, std::in_place_t, Args&&...>) {
+        return construct(std::forward<Args>(args)...);
+    } else if constexpr (std::is_constructible_v<Impl, std::in_place_t, Args&&...>) {
+        return construct(std::in_place, std::forward<Args>(args)...);
+    } else {
+        return construct(T(std::forward<Args>(args)...));
+    }
+}
+
+inline bool same_resource(std::pmr::memory_resource * a, std::pmr::memory_resource * b) noexcept {
+    return a == b || (a && b && a->is_equal(*b));
+}
+
+
+/// ===== [ Shared placement ] =====
+/// shared_header: the reference counts of a shared_some, in front of the object in the same allocation (see shared_some.hpp)
+struct shared_header {
+    std::atomic<std::size_t> strong {1};
+    std::atomic<std::size_t> weak {1}; ///< +1 for all the strong references together, as in std::shared_ptr
+    void (*manage)(shared_header *, bool deallocate) noexcept; ///< destroys the object or frees the whole block
+};
+
+/// shared_block<Impl>: the header and the Impl, allocated with the global new
+template <typename Impl>
+struct shared_block : shared_header {
+    template <typename... Args>
+    explicit shared_block(Args&&... args) : shared_header{.manage = &manage_block} {
+        std::construct_at(&object, std::forward<Args>(args)...);
+    }
+
+    ~shared_block() {} // the object is destroyed on its own, when the last strong reference goes
+
+    union { Impl object; };
+
+private:
+    static void manage_block(shared_header * header, bool deallocate) noexcept {
+        auto * block = static_cast<shared_block *>(header);
+        if (deallocate) { delete block; } else { std::destroy_at(&block->object); }
+    }
+};
+
+/// resource_holder: the memory resource of a some/fsome, empty unless the config asks for one
+template <bool enabled>
+struct resource_holder {
+    constexpr resource_holder() noexcept = default;
+    constexpr explicit resource_holder(std::pmr::memory_resource *) noexcept {}
+    static constexpr std::pmr::memory_resource * resource() noexcept { return nullptr; }
+    static constexpr bool payload_is_trivial() noexcept { return false; }
+    static constexpr void mark_trivial_payload(bool) noexcept {}
+    static constexpr bool skips_release(bool) noexcept { return false; }
+};
+
+///@note: the resource defaults to the current vx::arena, if there's one
+///@note: the lowest bit of the resource pointer tells whether the payload is trivially destructible
+template <>
+struct resource_holder<true> {
+    resource_holder() noexcept = default;
+    explicit resource_holder(std::pmr::memory_resource * mr) noexcept : bits_{reinterpret_cast<std::uintptr_t>(mr)} {}
+
+    std::pmr::memory_resource * resource() const noexcept {
+        return reinterpret_cast<std::pmr::memory_resource *>(bits_ & ~trivial_payload_bit);
+    }
+
+    bool payload_is_trivial() const noexcept { return bits_ & trivial_payload_bit; }
+
+    void mark_trivial_payload(bool trivial) noexcept { bits_ = (bits_ & ~trivial_payload_bit) | std::uintptr_t{trivial}; }
+
+    /// the payload can be simply forgotten: it's trivially destructible and its memory
+    /// is either the SBO buffer or belongs to the current arena, that will reclaim it in bulk
+    bool skips_release(bool stored_in_sbo) const noexcept {
+        return payload_is_trivial() && (stored_in_sbo || resource() == arena::current());
+    }
+
+private:
+    static constexpr std::uintptr_t trivial_payload_bit = 1;
+    static_assert(alignof(std::pmr::memory_resource) > trivial_payload_bit);
+
+    std::uintptr_t bits_ = reinterpret_cast<std::uintptr_t>(arena::current_or_default());
+};
+
+/// allocator_aware: provides the allocator_type for the uses-allocator construction (pmr containers)
+template <bool enabled>
+struct allocator_aware {};
+
+template <>
+struct allocator_aware<true> {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+};
+
+inline std::pmr::polymorphic_allocator<> allocator_from(std::pmr::memory_resource * mr) noexcept {
+    return {mr ? mr : std::pmr::new_delete_resource()};
+}
+
+}// namespace detail
+
+namespace detail {
+/// an address unique to every type, a cheap key to look the types up by
+template <typename T>
+inline constexpr char type_key = 0;
+
+template <typename Impl, typename Base>
+Impl* impl_cast(Base * p) noexcept;
 }// namespace detail
 
 /// ===== [ TRAIT ] =====
@@ -213,13 +459,179 @@ struct trait {
 private:
     /// @note: Friend structs that should have access to the do_action:
     template <class Trait, typename T> friend struct impl_for;
-    template <typename Trait, std::size_t, std::size_t> friend struct storage_for;
+    template <typename Trait, std::size_t, std::size_t, bool, bool> friend struct storage_for;
     template <typename Trait, cfg::fsome> friend struct fsome;
+    template <typename Trait> friend class poly_vector;
+    template <typename Trait> friend class shared_some;
+    template <typename Trait> friend class cow_some;
+    template <class Trait> friend class poly_view;
+    template <typename Trait> friend class type_registry;
+    template <typename Trait, cfg::fsome> friend class soa_vector;
+    template <typename Impl, typename Base> friend Impl* detail::impl_cast(Base *) noexcept;
+
+    /// @brief: do_actions handles the memory-to-memory operations: copy, move, cleanup(for fsome), dispose(for pmr some)
+    /// @note: heap placements are made from the `mr` memory resource, or with the global new if it's null
+    virtual void* do_action(detail::opcode, [[maybe_unused]] void* buffer, cfg::SBO, [[maybe_unused]] void* extra=nullptr,
+                            [[maybe_unused]] std::pmr::memory_resource* mr=nullptr) { return nullptr; }
+
+    /// @brief: the type token of the most derived impl, i.e. &detail::type_key<impl<Trait, T>>
+    virtual const void* type_token() const noexcept { return nullptr; }
+};
+
+
+/// ===== [ TRIVIAL RELOCATION ] =====
+/// is_trivially_relocatable<T>: moving a T to a new place and destroying the old one is the same as a memcpy (P1144-style)
+/// @note: true for the trivially copyable types, specialize it for your own types to opt them in
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/// relocate: moves the object from `source` into the uninitialized `dest`, ending the lifetime of the source
+/// @returns: the relocated object
+template <typename T>
+T* relocate(T * source, T * dest) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        std::memcpy((void*)dest, (void const*)source, sizeof(T));
+        return std::launder(dest);
+    } else {
+        auto * relocated = std::construct_at(dest, std::move(*source));
+        std::destroy_at(source);
+        return relocated;
+    }
+}
+
+/// relocates the [first, last) range into the uninitialized (and non-overlapping) one starting at `dest`, one memcpy when trivial
+/// @returns: the end of the relocated range
+template <typename T>
+T* relocate(T * first, T * last, T * dest) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (first != last) { std::memcpy((void*)dest, (void const*)first, (last - first) * sizeof(T)); }
+        return std::launder(dest) + (last - first);
+    } else {
+        for (; first != last; ++first, ++dest) { relocate(first, dest); }
+        return dest;
+    }
+}
+
+
+namespace detail {
+/// the vptr of a polymorphic object (it's the first thing in there, the some_ptr relies on that as well)
+inline const void* vptr_of(const void * object) noexcept {
+    const void* vptr;
+    std::memcpy(&vptr, object, sizeof(vptr));
+    return vptr;
+}
+
+/// the vptr of the Base subobject of an Impl, remembered on the first successful impl_cast
+template <typename Impl, typename Base>
+inline std::atomic<const void*> impl_vptr {nullptr};
+
+/// impl_cast: a downcast to the exact impl type, the O(1) replacement for the dynamic_cast in try_get:
+/// a vptr compare, or, until the vptr is known, a compare of the type tokens (a virtual call)
+/// @note: a different impl type, even a derived one, is a miss
+/// @note: dynamic_cast is only left for the Base that isn't a base of the Impl (a cross-cast)
+template <typename Impl, typename Base>
+Impl* impl_cast(Base * p) noexcept {
+    using raw_impl_t = std::remove_cv_t<Impl>;
+    using raw_base_t = std::remove_cv_t<Base>;
+    if constexpr (not std::is_base_of_v<raw_base_t, raw_impl_t>) {
+        return dynamic_cast<Impl*>(p);
+    } else {
+        if (p == nullptr) { return nullptr; }
+        auto & cached = impl_vptr<raw_impl_t, raw_base_t>;
+        const void* vptr = vptr_of(p);
+        const void* known = cached.load(std::memory_order_relaxed);
+        if (vptr == known) { return static_cast<Impl*>(p); }
+        if (known != nullptr || p->type_token() != &type_key<raw_impl_t>) { return nullptr; }
+        cached.store(vptr, std::memory_order_relaxed);
+        return static_cast<Impl*>(p);
+    }
+}
+
+/// relocatable_vptrs<Key>: the vptrs of the impls (of the Key family) with a trivially relocatable payload,
+/// filled once per type at its first construction. A hit lets the fsome<>'s SBO move skip the do_action call,
+/// the bytes are copied over with a memcpy and the data pointer is fixed up.
+/// (the some<> keeps that fact in its trait pointer instead, see storage_for)
+/// @note: an open-addressing hash set, a lookup is a load or two however many types have registered
+/// @note: holds up to `capacity` types per Key, registering more is a bug (asserted): the extra types would silently
+///        lose the memcpy and take the virtual call
+/// @note: the Key is the Trait* of the fsome<> (the impl<Trait, T*>s)
+template <typename Key>
+struct relocatable_vptrs {
+    static constexpr std::size_t capacity = 256;
+
+    static bool contains(const void* vptr) noexcept {
+        for (std::size_t i = slot_of(vptr), probes = 0; probes < capacity; i = (i + 1) % capacity, ++probes) {
+            const void* known = table[i].load(std::memory_order_relaxed);
+            if (known == vptr) { return true; }
+            if (known == nullptr) { return false; }
+        }
+        return false;
+    }
+
+    static void add(const void* vptr) noexcept {
+        for (std::size_t i = slot_of(vptr), probes = 0; probes < capacity; i = (i + 1) % capacity, ++probes) {
+            const void* expected = nullptr;
+            if (table[i].compare_exchange_strong(expected, vptr, std::memory_order_relaxed) || expected == vptr) { return; }
+        }
+        assert(( not "vx::detail::relocatable_vptrs: too many trivially relocatable types for one trait" ));
+    }
+
+private:
+    /// Fibonacci hashing: the vptrs are aligned and close to each other, the multiplication spreads them
+    static std::size_t slot_of(const void* vptr) noexcept {
+        constexpr int bits = std::bit_width(capacity - 1);
+        return static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(vptr) * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+    }
 
-    /// @brief: do_actions handles the memory-to-memory operations: copy, move, cleanup(for fsome)
-    virtual void* do_action(detail::opcode, [[maybe_unused]] void* buffer, cfg::SBO, [[maybe_unused]] void* extra=nullptr) { return nullptr; }
+    static_assert(std::has_single_bit(capacity));
+    static inline std::atomic<const void*> table[capacity] {};
 };
 
+/// registers the vptr of the (just constructed) Impl object, once per Impl
+template <typename Key, typename Impl>
+void remember_relocatable(const void* object) noexcept {
+    [[maybe_unused]] static const bool once = (relocatable_vptrs<Key>::add(vptr_of(object)), true);
+}
+
+/// fsome_heap<Trait, X>: the heap placement of an fsome<Trait>'s X. It is the impl<Trait, X> a some<Trait> allocates,
+/// the fsome points to the X inside it: a heap-resident object changes hands between them as is (see opcode::hand_over_block).
+/// A bare X for the objects the impl<Trait, X> can't be made of (an abstract or a pointer-like X)
+/// @note: the block is found back from its X by the X's offset in the impl_for, a compile-time constant
+template <typename Trait, typename X>
+struct fsome_heap {
+    static constexpr bool in_block = not std::is_abstract_v<X> && not pointer_like<X>;
+
+    /// a new X (in a new block) out of its constructor arguments (see new_impl)
+    template <typename... Args>
+    static X * make(std::pmr::memory_resource * mr, Args&&... args) {
+        if constexpr (in_block) {
+            return object_in(new_impl<vx::impl<Trait, X>, X>(nullptr, mr, std::forward<Args>(args)...));
+        } else {
+            return heap_new<X>(mr, std::forward<Args>(args)...);
+        }
+    }
+
+    static X * object_in(vx::impl<Trait, X> * block) noexcept requires (in_block) { return &block->self_; }
+
+    static vx::impl<Trait, X> * block_of(X * object) noexcept requires (in_block) {
+        auto * base = reinterpret_cast<std::byte*>(object) - impl_for<Trait, X>::self_offset();
+        return static_cast<vx::impl<Trait, X> *>(std::launder(reinterpret_cast<impl_for<Trait, X> *>(base)));
+    }
+
+    static void destroy(std::pmr::memory_resource * mr, X * object) noexcept {
+        if constexpr (in_block) { heap_delete(mr, block_of(object)); } else { heap_delete(mr, object); }
+    }
+
+    struct deleter {
+        std::pmr::memory_resource * mr = nullptr;
+        void operator() (X * object) const noexcept { destroy(mr, object); }
+    };
+};
+}// namespace detail
+
 
 /// @brief A helper to facilitate simpler creation of the user-defined traits by inheriting from it
 /// @note Inheriting the impl_for constructors is adviced for most of the non-trivial traits
@@ -253,6 +665,13 @@ struct impl_for : Trait {
     noexcept(std::is_nothrow_constructible_v<value_type, decltype(other)>)
     : self_{std::forward<decltype(other)>(other)} {}
 
+    /// the T constructed in place, out of its constructor arguments (some::emplace)
+    template <typename... Args>
+    requires std::is_constructible_v<value_type, Args&&...>
+    explicit impl_for(std::in_place_t, Args&&... args)
+    noexcept(std::is_nothrow_constructible_v<value_type, Args&&...>)
+    : self_(std::forward<Args>(args)...) {}
+
     const auto* operator->() const { return get(); }
 
     auto* operator->() { return get(); }
@@ -286,17 +705,38 @@ struct impl_for : Trait {
     }
 
 private:
+    template <typename, typename> friend struct detail::fsome_heap;
+
+    /// the offset of the self_, see detail::fsome_heap: the offsetof of a class that isn't standard-layout
+    /// is conditionally supported, GCC and Clang take it for a class with no virtual bases
+    static constexpr std::size_t self_offset() noexcept {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+        return offsetof(impl_for, self_);
+#pragma GCC diagnostic pop
+    }
+
     [[no_unique_address]] value_type self_{};
 
 protected:
-    virtual void* do_action(detail::opcode op, [[maybe_unused]] void* buffer, [[maybe_unused]] cfg::SBO sbo, [[maybe_unused]] void* extra=nullptr) override {
+    virtual void* do_action(detail::opcode op, void* buffer, cfg::SBO sbo, void* extra=nullptr, std::pmr::memory_resource* mr=nullptr) override {
+        return do_action_as<impl<Trait,T>, Trait>(op, buffer, sbo, extra, mr);
+    }
+
+    virtual const void* type_token() const noexcept override { return &detail::type_key<impl<Trait,T>>; }
+
+    /// @brief: the actual do_action, done on behalf of the most derived `Impl` (which is not impl<Trait,T> for the mixed traits)
+    /// @tparam Impl: the type of the whole polymorphic object, this is what gets copied, moved and disposed of
+    /// @tparam Main: the trait subobject that the some<>'s storage points to, returned pointers point to it
+    template <class Impl, class Main>
+    void* do_action_as(detail::opcode op, [[maybe_unused]] void* buffer, [[maybe_unused]] cfg::SBO sbo, 
+                       [[maybe_unused]] void* extra, [[maybe_unused]] std::pmr::memory_resource* mr) {
         VX_SOME_LOG("(vcall) do_action");
         switch (op) {
             using enum detail::opcode;
             case copy_into: if constexpr (std::is_copy_constructible_v<Self>) {
                 VX_SOME_LOG("copy_into");
                 VX_SOME_LOG("sbo{"<< sbo.size << ", " << sbo.alignment << "}");
-                // if (sizeof(T) <= sbo.size && alignof(T) <= sbo.alignment) {
                 if constexpr (std::is_pointer_v<T>) { 
                     /// fsome copy
                     using Data = Self; //detail::remove_ref_or_ptr_t<T>;
@@ -304,35 +744,49 @@ protected:
                     Data * p_object = detail::is_sbo_eligible_with<Data>(sbo.size, sbo.alignment) ?
                         new(buffer) Data( static_cast<Data const&>(self()) )
                         :
-                        new Data( static_cast<Data const&>(self()) );
+                        detail::fsome_heap<Main, Data>::make(mr, static_cast<Data const&>(self()) );
 
-                    auto * p_impl { static_cast<impl<Trait, T> *>( extra ) };
-                    new(p_impl) impl<Trait,T> (p_object);
+                    auto * p_impl { static_cast<Impl *>( extra ) };
+                    new(p_impl) Impl (p_object);
                 } else if constexpr (std::is_object_v<T>) { 
                     /// some copy
-                    /// The T is the object itself, stored inside the impl<Trait, T>
-                    if (detail::is_sbo_eligible_with<T>(sbo.size, sbo.alignment)) {
+                    /// The T is the object itself, stored inside the Impl
+                    report_placement<Self>(extra);
+                    if (sbo_admits<Impl, Self>(sbo, extra)) {
                         VX_SOME_LOG("[SBO]");
-                        return new(buffer) impl<Trait,T>(self_);
+                        return static_cast<Main*>(new(buffer) Impl(self_));
                     } 
                     VX_SOME_LOG("[PTR]");
-                    return new impl<Trait,T>(self_);
+                    return static_cast<Main*>(detail::heap_new<Impl>(mr, self_));
                 }
             } break;
 
             ///@note move-operation for some<>
             case move_into: 
-            if constexpr (vx::rvalue<T&&> && requires { impl<Trait,T>(std::move(self_)); }) {
+            if constexpr (std::is_pointer_v<T>) {
+                /// fsome -> some: the object is moved out of the fsome's placement into an impl<Trait, T> of the some
+                if constexpr (std::is_move_constructible_v<Self>) {
+                    VX_SOME_LOG("MOVE [from fsome]");
+                    using Target = vx::impl<Main, Self>;
+                    report_placement<Self>(extra);
+                    if constexpr (std::is_nothrow_move_constructible_v<Self>) {
+                        if (sbo_admits<Target, Self>(sbo, extra)) {
+                            return static_cast<Main*>(new(buffer) Target(std::move(self())));
+                        }
+                    }
+                    return static_cast<Main*>(detail::heap_new<Target>(mr, std::move(self())));
+                }
+            } else if constexpr (vx::rvalue<T&&> && requires { Impl(std::move(self_)); }) {
                 VX_SOME_LOG("MOVE ");
-                if constexpr (noexcept(impl<Trait,T>(std::move(self_)))) { 
-                    // if (sizeof(T) <= sbo.size && alignof(T) <= sbo.alignment) {
-                    if (detail::is_sbo_eligible_with<T>(sbo.size, sbo.alignment)) {
+                report_placement<Self>(extra);
+                if constexpr (noexcept(Impl(std::move(self_)))) { 
+                    if (sbo_admits<Impl, Self>(sbo, extra)) {
                         VX_SOME_LOG("[SBO]");
-                        return new(buffer) impl<Trait,T>(std::move(self_));
+                        return static_cast<Main*>(new(buffer) Impl(std::move(self_)));
                     }
                 }
                 VX_SOME_LOG("[PTR]");
-                return new impl<Trait, T>(std::move(self_)); 
+                return static_cast<Main*>(detail::heap_new<Impl>(mr, std::move(self_))); 
             } break;
 
             ///@note the non-SBO case will be efficiently handled w/o the vcall
@@ -343,10 +797,34 @@ protected:
                 Data * p_object = detail::is_sbo_eligible_with<Self>(sbo.size, sbo.alignment) ?
                     new(buffer) Self( std::move(self()) ) // fits into new SBO buffer => in-place move construct
                     :
-                    new Self( std::move(self()) ); // else, allocate memory for it on the heap
+                    detail::fsome_heap<Main, Self>::make(mr, std::move(self()) ); // else, allocate memory for it on the heap
                 
-                auto * p_impl { static_cast<impl<Trait, T> *>( extra ) };
-                new(p_impl) impl<Trait,T> (p_object);
+                auto * p_impl { static_cast<Impl *>( extra ) };
+                new(p_impl) Impl (p_object);
+            } else if constexpr (std::is_object_v<T> && std::is_move_constructible_v<Self> && not detail::pointer_like<Self>) {
+                /// some -> fsome: the object is moved out of the impl<Trait, T> into the fsome's placement
+                /// (not a pointer-like one: the fsome's impl<Trait, T*> would call the smart pointer, not its pointee)
+                VX_SOME_LOG("fsome_move_sbo_into [from some]");
+                Self * p_object = detail::is_sbo_eligible_with<Self>(sbo.size, sbo.alignment) ?
+                    new(buffer) Self( std::move(self_) )
+                    :
+                    detail::fsome_heap<Main, Self>::make(mr, std::move(self_) );
+                new(extra) vx::impl<Main, Self*> (p_object);
+            } break;
+
+            //!@note: used exclusively between some<> and fsome<> with the same memory resource: the heap-resident object
+            //! changes hands in the impl<Trait, T> it lives in (see detail::fsome_heap), nothing is allocated or moved.
+            //! Returns null if the object isn't in such a block, it's moved then
+            case hand_over_block:
+            if constexpr (std::is_pointer_v<T>) {
+                /// fsome -> some: the block of the pointee is returned
+                if constexpr (detail::fsome_heap<Main, Self>::in_block) {
+                    return static_cast<Main*>(detail::fsome_heap<Main, Self>::block_of(self_));
+                }
+            } else if constexpr (std::is_same_v<Impl, vx::impl<Main, Self>> && detail::fsome_heap<Main, Self>::in_block) {
+                /// some -> fsome: an impl<Main, T*> pointing into this block is constructed at the `extra`
+                new(extra) vx::impl<Main, Self*> (detail::fsome_heap<Main, Self>::object_in(static_cast<Impl*>(this)));
+                return extra;
             } break;
 
             #if not VX_FSOME_ELIDE_VCALL_ON_MOVE
@@ -355,7 +833,7 @@ protected:
                 VX_SOME_LOG("fsome_move_ptr_into [safe mode]");
                 // self_ is a pointer to the heap-allocated object
                 // extra is a pointer to the target's some_ptr.iface
-                new(extra) impl<Trait, T> (std::exchange(self_, nullptr));
+                new(extra) Impl (std::exchange(self_, nullptr));
             } break;
             #endif
 
@@ -364,13 +842,12 @@ protected:
                 VX_SOME_LOG("cleanup");
                 if constexpr (std::is_pointer_v<value_type>) {
                     using Data = std::remove_pointer_t<value_type>;
-                    // if (sbo.size == 0) {
                     VX_SOME_LOG("buffer v self_ v &self");
                     VX_SOME_LOG(buffer << " v " << self_ << " v " << &self_);
                     if (buffer != self_) {
-                        // allocated on the heap
+                        // allocated on the heap, in its impl<Trait, T> (see detail::fsome_heap)
                         VX_SOME_LOG("dtor::HEAP");
-                        delete static_cast<value_type>(self_);
+                        detail::fsome_heap<Main, Data>::destroy(mr, self_);
                     } else {
                         // SBO
                         VX_SOME_LOG("dtor::SBO");
@@ -378,33 +855,83 @@ protected:
                     }
                 }
             } break;
+
+            //!@note: used exclusively in some<> with a memory resource, for the heap-allocated objects
+            //! the object destroys itself and gives the memory back to the resource it came from
+            case dispose: {
+                VX_SOME_LOG("dispose");
+                detail::heap_delete(mr, static_cast<Impl*>(this));
+            } break;
+
+            //!@note: used exclusively in shared_some and cow_some: the object is moved (share_into, from an rvalue some<>,
+            //! copied if it can't be moved) or copied (share_copy_into, the copy-on-write) into a new shared block,
+            //! the block's header is written to the `extra` (a detail::shared_header**)
+            case share_into:
+            case share_copy_into: if constexpr (std::is_object_v<T> && not std::is_pointer_v<T>) {
+                VX_SOME_LOG("share_into");
+                detail::shared_block<Impl> * block = nullptr;
+                if constexpr (requires { Impl(std::move(self_)); }) {
+                    if (op == share_into) { block = new detail::shared_block<Impl>(std::move(self_)); }
+                }
+                if constexpr (std::is_copy_constructible_v<Self>) {
+                    if (not block) { block = new detail::shared_block<Impl>(self_); }
+                }
+                if (not block) { break; }
+                *static_cast<detail::shared_header **>(extra) = block;
+                return static_cast<Main*>(&block->object);
+            } break;
+
+            //!@note: used exclusively in poly_view: an impl<Main, X&> viewing the object is constructed at the `extra`
+            //! (the object of a some<>'s impl<Trait, T> or the pointee of an fsome<>'s impl<Trait, T*>)
+            case view_into: if constexpr (std::is_object_v<T>) {
+                VX_SOME_LOG("view_into");
+                using X = std::remove_reference_t<decltype(self())>;
+                new(extra) vx::impl<Main, X&> (self());
+            } break;
         }
         return nullptr;
     }
+
+    /// fills the detail::placement of a copy_into/move_into into a some<> storage (see storage_for::reset)
+    template <typename X>
+    static void report_placement(void* extra) noexcept {
+        if (extra) { static_cast<detail::placement*>(extra)->relocatable = vx::is_trivially_relocatable_v<X>; }
+    }
+
+    /// the X (in its Placed impl) may go into the SBO of a copy_into/move_into: it fits,
+    /// and it's trivially relocatable if the storage asks for that (see detail::placement), decided here, at compile time
+    template <typename Placed, typename X>
+    static bool sbo_admits(cfg::SBO sbo, void* extra) noexcept {
+        bool const relocatable_only = extra && static_cast<detail::placement*>(extra)->relocatable_only;
+        return detail::is_sbo_eligible_with<Placed>(sbo.size, sbo.alignment) && (vx::is_trivially_relocatable_v<X> || not relocatable_only);
+    }
 };
 
 
 template <class CRTP, typename Trait>
 struct basic_operations_for {
 
-    auto* operator-> () noexcept { return iface(); }
+    /// noexcept unless the trait_ptr() may throw (the check_empty, cow_some's copy-on-write)
+    auto* operator-> () noexcept(noexcept(std::declval<CRTP&>().trait_ptr())) { return iface(); }
+
+    const auto* operator-> () const noexcept(noexcept(std::declval<CRTP const&>().trait_ptr())) { return iface(); }
 
-    const auto* operator-> () const noexcept { return iface(); }
+    auto& operator*() { return *iface(); }
 
-    Trait& operator*() const { return *iface(); }
+    const auto& operator*() const { return *iface(); }
 
     template <typename Target>
     Target* try_get() {
         // std::cerr << "CRTP base: " << vx::type <CRTP> << "\n";
         // std::cerr << "IMPL TYPE: " << vx::type< typename CRTP::template impl_type<Target> > << "\n";
-        auto * impl = dynamic_cast<CRTP::template impl_type<Target>*>(iface());
+        auto * impl = detail::impl_cast<typename CRTP::template impl_type<Target>>(iface());
         return impl ? &impl->self() : nullptr;
     }
 
     template <typename Target>
     const Target* try_get() const noexcept {
         using X = std::remove_const_t<Target>; // for fsome, poly_view and some_ptr that store const-less type
-        auto * impl = dynamic_cast<CRTP::template impl_type<X> const*>(iface());
+        auto * impl = detail::impl_cast<typename CRTP::template impl_type<X> const>(iface());
         return impl ? &impl->self() : nullptr;
     }
 
@@ -472,12 +999,19 @@ struct empty_some_access : std::runtime_error {
     using std::runtime_error::runtime_error;
 };
 
+/// a conversion between some<> and fsome<> the object can't make (see fsome(some&&))
+struct bad_some_conversion : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
 /// ===== [ SOME PTR ] =====
 /// Pointer to a (to-be)polymorphic object
 template <class Trait, bool checked=false>
 class some_ptr : public basic_operations_for<some_ptr<Trait>, std::remove_cv_t<Trait>> {
     friend struct basic_operations_for<some_ptr<Trait>, std::remove_cv_t<Trait>>;
     template <typename, cfg::fsome> friend struct fsome;
+    template <typename> friend class type_registry;
+    template <typename, cfg::fsome> friend class soa_vector;
 
     using layout = struct { void* vptr; void* dptr; };
     
@@ -568,6 +1102,18 @@ public:
         // other = some_ptr();
     }
 
+    /// drops the representation without running the impl<Trait, T*> destructor, leaving `this` empty
+    void forget() noexcept {
+        new(&iface) layout{nullptr, nullptr};
+    }
+
+    /// takes over the other's vptr with the data pointer fixed up to `dptr` (where the data was relocated to),
+    /// leaving the other empty, no virtual call (same caveats as steal_trait_from)
+    void relocate_from(some_ptr & other, void * dptr) noexcept {
+        new(&iface) layout{other.inspect().vptr, dptr};
+        other.forget();
+    }
+
     inline layout inspect() const noexcept {
         return std::bit_cast<layout>(iface);
     }
@@ -634,7 +1180,8 @@ class poly_view : public basic_operations_for<poly_view<Trait>, std::remove_cv_t
 public:
 
     template <typename T>
-    requires (std::is_const_v<Trait> || not std::is_const_v<std::remove_reference_t<T>>)
+    requires ((std::is_const_v<Trait> || not std::is_const_v<std::remove_reference_t<T>>)
+              && not std::is_base_of_v<poly_view, std::remove_cvref_t<T>>)
     constexpr poly_view(T && ref) {
         static_assert(not rvalue<T&&>, "cannot be used with poly_view, use some<...> const& for that");
         using R = detail::remove_innermost_const<T>; //std::add_lvalue_reference_t<std::remove_const_t<std::remove_reference_t<T>>>; // remove inner constness
@@ -642,6 +1189,46 @@ public:
         new(&iface) impl<raw_trait_t, R>{const_cast<R>(ref)};
     }
 
+    /// views the object held by the some<> (not the some<> itself): its impl makes the impl<Trait, T&> (a virtual call)
+    template <cfg::some config>
+    requires (not detail::mixed_traits<raw_trait_t>::value)
+    poly_view(some<raw_trait_t, config> & owner) {
+        view_into(owner.storage.get());
+    }
+
+    template <cfg::some config>
+    requires (std::is_const_v<Trait> && not detail::mixed_traits<raw_trait_t>::value)
+    poly_view(some<raw_trait_t, config> const& owner) {
+        view_into(owner.storage.get());
+    }
+
+    /// views the object held by the fsome<>: its impl<Trait, T*> makes the impl<Trait, T&> (a virtual call),
+    /// so that try_get<T> and some_cast find the T through the view
+    template <cfg::fsome config>
+    requires (not detail::mixed_traits<raw_trait_t>::value)
+    poly_view(fsome<raw_trait_t, config> & owner) {
+        if (not owner.vptr()) { throw empty_some_access{"empty fsome<> viewed"}; }
+        view_into(owner.operator->());
+    }
+
+    template <cfg::fsome config>
+    requires (std::is_const_v<Trait> && not detail::mixed_traits<raw_trait_t>::value)
+    poly_view(fsome<raw_trait_t, config> const& owner) {
+        if (not owner.vptr()) { throw empty_some_access{"empty fsome<> viewed"}; }
+        view_into(const_cast<raw_trait_t *>(owner.operator->()));
+    }
+
+
+    /// the copy views the same object: the impl<Trait, T&> is a vptr and a reference, 
+    /// so it is copied bitwise (see some_ptr::steal_trait_from for the caveats)
+    poly_view(poly_view const& other) noexcept {
+        std::memcpy(&iface, &other.iface, k_trait_size);
+    }
+
+    poly_view& operator= (poly_view const& other) noexcept {
+        std::memcpy(&iface, &other.iface, k_trait_size);
+        return *this;
+    }
 
     //!@brief: Will do the first part: reinterpreting the iface as Trait*
     //! The rest will work due to the virtual destructor in Trait class.
@@ -657,6 +1244,19 @@ public:
 
 protected:
     friend struct basic_operations_for<poly_view<Trait>, std::remove_cv_t<Trait>>;
+    template <typename> friend class mapped_store;
+
+    /// put together from the vptr of an impl<Trait, T&> and the address of a T that no one owns (see mapped_store)
+    struct from_bits_t {};
+    poly_view(from_bits_t, const void * vptr, const void * dptr) noexcept {
+        struct { const void* vptr; const void* dptr; } layout {vptr, dptr};
+        std::memcpy(&iface, &layout, k_trait_size);
+    }
+
+    void view_into(raw_trait_t * object) {
+        if (not object) { throw empty_some_access{"empty some<> viewed"}; }
+        object->do_action(detail::opcode::view_into, nullptr, {}, &iface);
+    }
 
     std::add_pointer_t<const raw_trait_t> trait_ptr() const noexcept {
         return std::launder(reinterpret_cast<std::add_pointer_t<const raw_trait_t>>(&iface));
@@ -676,8 +1276,12 @@ protected:
 
 
 /// ===== [ STORAGE ] =====
-template <typename Trait, std::size_t SBO_capacity, std::size_t alignment>
-struct storage_for {
+/// @tparam relocatable_layout: the SBO residency is marked with a tag instead of a pointer into the buffer, 
+///         so that the storage can be relocated with a memcpy. Only the trivially relocatable objects get into the SBO then.
+/// @note: a trivially relocatable object in the SBO is known by its p_trait: the lowest bit is set (it's otherwise 0, 
+///        the trait has a vptr), or it is the sbo_tag in the relocatable layout. Its move is then a memcpy, no virtual call.
+template <typename Trait, std::size_t SBO_capacity, std::size_t alignment, bool pmr, bool relocatable_layout>
+struct storage_for : detail::resource_holder<pmr> {
     using main_trait_t = first_trait_from<Trait>;
 
     template <typename X>
@@ -685,16 +1289,16 @@ struct storage_for {
 
     storage_for() = default;
 
+    explicit storage_for(std::pmr::memory_resource * mr) noexcept : detail::resource_holder<pmr>{mr} {}
+
     template <typename T>
     explicit storage_for(T&& object) {
-        using impl_type = vx::impl< Trait, std::decay_t<T> >;
-        if constexpr (is_sbo_eligible<impl_type>) { 
-            /// [sbo] created in-place in SBO buffer
-            p_trait = new(&buffer) impl_type(std::forward<T>(object));
-        } else {
-            /// [ptr] allocated and assigned to ptr
-            p_trait = new impl_type(std::forward<T>(object));
-        }
+        set(std::forward<T>(object));
+    }
+
+    template <typename T>
+    storage_for(std::pmr::memory_resource * mr, T&& object) : detail::resource_holder<pmr>{mr} {
+        set(std::forward<T>(object));
     }
 
 
@@ -706,57 +1310,147 @@ struct storage_for {
 
     inline void clear() {
         if (not p_trait) { return; }
-        if (this->stored_in_sbo()) {
-            p_trait->~main_trait_t();
+        if (this->skips_release(this->stored_in_sbo())) {
+            // trivially destructible payload, the memory is either ours or the arena's: nothing to do
+        } else if (this->stored_in_sbo()) {
+            get()->~main_trait_t();
+        } else if constexpr (pmr) {
+            p_trait->do_action(detail::opcode::dispose, nullptr, {}, nullptr, this->resource());
         } else {
             delete p_trait;
         }
-        // p_trait = nullptr;
+        p_trait = nullptr;
     }
     
     template <typename T>
     inline void set(T&& data) {
-        using impl_type = vx::impl< Trait, std::decay_t<T> >;
-        if constexpr (is_sbo_eligible<impl_type>) { 
+        emplace<std::decay_t<T>>(std::forward<T>(data));
+    }
+
+    /// the T constructed right in its placement out of the args (see detail::new_impl)
+    template <typename T, typename... Args>
+    inline void emplace(Args&&... args) {
+        using impl_type = vx::impl< Trait, T >;
+        constexpr bool trivially_relocatable = vx::is_trivially_relocatable_v<T>;
+        this->mark_trivial_payload(std::is_trivially_destructible_v<T>);
+        if constexpr (is_sbo_eligible<impl_type> && (trivially_relocatable || not relocatable_layout)) { 
             /// [sbo] created in-place in SBO buffer
-            p_trait = new(&buffer) impl_type(std::forward<T>(data));
+            reset(detail::new_impl<impl_type, T>(&buffer, nullptr, std::forward<Args>(args)...), {.relocatable = trivially_relocatable});
         } else {
             /// [ptr] allocated and assigned to ptr
-            p_trait = new impl_type(std::forward<T>(data));
+            p_trait = detail::new_impl<impl_type, T>(nullptr, this->resource(), std::forward<Args>(args)...);
         }
     }
 
 
     //!@note: Expects the dest to be in a reset state, i.e. the previously occuping object has been destroyed
-    template <std::size_t dest_SBO, std::size_t dest_alignment>
-    void copy_into(storage_for<Trait, dest_SBO, dest_alignment> & dest) const {
-        dest.p_trait = (main_trait_t*)p_trait->do_action(detail::opcode::copy_into, (void*)&dest, {dest_SBO, dest_alignment});
+    template <std::size_t dest_SBO, std::size_t dest_alignment, bool dest_pmr, bool dest_layout>
+    void copy_into(storage_for<Trait, dest_SBO, dest_alignment, dest_pmr, dest_layout> & dest) const {
+        if (not p_trait) { return; }
+        auto placed = dest.placement();
+        dest.reset((main_trait_t*)get()->do_action(detail::opcode::copy_into, dest.sbo_buffer(), dest.sbo(), &placed, dest.resource()),
+                   placed);
+        dest.mark_trivial_payload(this->payload_is_trivial());
     }
 
 
     //!@note: Expects the dest to be in a reset state, i.e. the previously occuping object has been destroyed
-    template <std::size_t dest_SBO, std::size_t dest_alignment>
-    void move_into(storage_for<Trait, dest_SBO, dest_alignment> & dest) && noexcept {
-        if (this->stored_in_sbo()) {
-            dest.p_trait = (main_trait_t*)p_trait->do_action(detail::opcode::move_into, (void*)&dest.buffer, {dest_SBO, dest_alignment});
+    //!@note: The heap-allocated object is handed over as is if both sides share the memory resource
+    //!@note: The trivially relocatable object in the SBO is moved with a memcpy, leaving `this` empty
+    //!@note: The dest may hold a base of our trait (see detail::narrows_to), the object is then owned through that base
+    template <typename DestTrait, std::size_t dest_SBO, std::size_t dest_alignment, bool dest_pmr, bool dest_layout>
+    void move_into(storage_for<DestTrait, dest_SBO, dest_alignment, dest_pmr, dest_layout> & dest) && noexcept(not pmr && not dest_pmr) {
+        if (not p_trait) { return; }
+        dest.mark_trivial_payload(this->payload_is_trivial());
+        if constexpr (dest_SBO >= SBO_capacity && dest_alignment >= alignment) {
+            if (relocatable_in_sbo()) {
+                // the whole buffer is copied over, the object is somewhere in there at the start of it
+                // the bytes past the object may be indeterminate: copying them is fine, GCC's -O1 flow analysis says otherwise
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+                std::memcpy(dest.sbo_buffer(), &buffer, SBO_capacity);
+#pragma GCC diagnostic pop
+                dest.reset(std::launder(reinterpret_cast<main_trait_t*>(dest.sbo_buffer())), {.relocatable = true});
+                p_trait = nullptr;
+                return;
+            }
+        }
+        if (this->stored_in_sbo() || not detail::same_resource(this->resource(), dest.resource())) {
+            auto placed = dest.placement();
+            dest.reset(static_cast<main_trait_t*>(get()->do_action(detail::opcode::move_into, dest.sbo_buffer(), dest.sbo(), &placed, dest.resource())),
+                       placed);
         } else {
-            dest.p_trait = std::exchange(p_trait, nullptr);
+            dest.reset(std::exchange(p_trait, nullptr));
         }
     }
 
 
-    bool stored_in_sbo() {
-        return (void*)p_trait == (void*)&buffer;
+    /// the stored object (or nullptr)
+    main_trait_t * get() const noexcept {
+        if constexpr (relocatable_layout) {
+            return stored_in_sbo() ? std::launder(reinterpret_cast<main_trait_t*>(const_cast<std::byte*>(buffer))) : p_trait;
+        } else {
+            return reinterpret_cast<main_trait_t*>(reinterpret_cast<std::uintptr_t>(p_trait) & ~relocatable_bit);
+        }
+    }
+
+    /// takes the object, which is either in our SBO buffer or on the heap
+    /// @param placed: what is known about the object (whether it's trivially relocatable matters for the one in the SBO),
+    ///        read here, once the do_action that fills it is over
+    void reset(main_trait_t * p, [[maybe_unused]] detail::placement const& placed = {}) noexcept {
+        if ((void*)p == (void*)&buffer) {
+            if constexpr (relocatable_layout) {
+                p_trait = sbo_tag();
+            } else {
+                p_trait = reinterpret_cast<main_trait_t*>(reinterpret_cast<std::uintptr_t>(p) | (placed.relocatable ? relocatable_bit : 0));
+            }
+            return;
+        }
+        p_trait = p;
     }
 
+    bool stored_in_sbo() const noexcept {
+        if constexpr (relocatable_layout) {
+            return p_trait == sbo_tag();
+        } else {
+            return (void*)get() == (void*)&buffer;
+        }
+    }
+
+    /// the object is in the SBO and is trivially relocatable: it can be moved with a memcpy
+    bool relocatable_in_sbo() const noexcept {
+        if constexpr (relocatable_layout) {
+            return p_trait == sbo_tag(); // only the trivially relocatable objects get into the SBO
+        } else {
+            return reinterpret_cast<std::uintptr_t>(p_trait) & relocatable_bit;
+        }
+    }
+
+    /// the SBO the copy_into/move_into placements may use
+    static constexpr cfg::SBO sbo() noexcept { return {SBO_capacity, alignment}; }
+
+    /// what the copy_into/move_into placements are asked for: the relocatable layout only lets the trivially relocatable objects
+    /// into the SBO, the impl knows that about its object at compile time (see impl_for::sbo_admits)
+    static constexpr detail::placement placement() noexcept { return {.relocatable_only = relocatable_layout}; }
+
+    void* sbo_buffer() noexcept { return &buffer; }
+
 
     alignas(alignment) std::byte buffer[SBO_capacity];
-    main_trait_t * p_trait = nullptr;
+    main_trait_t * p_trait = nullptr; ///< points into the buffer if the object is in the SBO (or is the sbo_tag in the relocatable layout)
+                                      ///< +1 for a trivially relocatable one, see relocatable_in_sbo(); use get() for the object
+
+private:
+    static constexpr std::uintptr_t relocatable_bit = 1;
+    static_assert(alignof(main_trait_t) > relocatable_bit);
+
+    /// never a valid pointer to an object: it's not aligned for the main_trait_t
+    static main_trait_t * sbo_tag() noexcept { return reinterpret_cast<main_trait_t*>(std::uintptr_t{1}); }
 };
 
 
-template <typename Trait, std::size_t Alignment>
-struct storage_for<Trait, 0, Alignment> {
+template <typename Trait, std::size_t Alignment, bool pmr, bool relocatable_layout>
+struct storage_for<Trait, 0, Alignment, pmr, relocatable_layout> : detail::resource_holder<pmr> {
     using main_trait_t = first_trait_from<Trait>;
     main_trait_t *p_trait = nullptr;
 
@@ -765,10 +1459,16 @@ struct storage_for<Trait, 0, Alignment> {
 
     storage_for() = default;
 
+    explicit storage_for(std::pmr::memory_resource * mr) noexcept : detail::resource_holder<pmr>{mr} {}
+
     template <typename T>
     explicit storage_for(T&& object) {
-        using impl_type = vx::impl< Trait, std::decay_t<T> >;
-        p_trait = new impl_type(std::forward<T>(object));
+        set(std::forward<T>(object));
+    }
+
+    template <typename T>
+    storage_for(std::pmr::memory_resource * mr, T&& object) : detail::resource_holder<pmr>{mr} {
+        set(std::forward<T>(object));
     }
 
     ~storage_for() {
@@ -777,27 +1477,66 @@ struct storage_for<Trait, 0, Alignment> {
     }
 
     inline void clear() { 
-        if (p_trait) delete p_trait; 
+        if (not p_trait) { return; }
+        if (this->skips_release(false)) {
+            // trivially destructible payload in the arena: nothing to do
+        } else if constexpr (pmr) {
+            p_trait->do_action(detail::opcode::dispose, nullptr, {}, nullptr, this->resource());
+        } else {
+            delete p_trait; 
+        }
+        p_trait = nullptr;
     }
     
     template <typename T>
     inline void set(T&& data) {
-        using impl_type = vx::impl< Trait, std::decay_t<T> >;
-        p_trait = new impl_type(std::forward<T>(data));
+        emplace<std::decay_t<T>>(std::forward<T>(data));
+    }
+
+    template <typename T, typename... Args>
+    inline void emplace(Args&&... args) {
+        using impl_type = vx::impl< Trait, T >;
+        this->mark_trivial_payload(std::is_trivially_destructible_v<T>);
+        p_trait = detail::new_impl<impl_type, T>(nullptr, this->resource(), std::forward<Args>(args)...);
     }
 
     //!@note: Expects the dest to be in a reset state, i.e. the previously occuping object has been destroyed
-    template <std::size_t dest_SBO, std::size_t dest_alignment>
-    void copy_into(storage_for<Trait, dest_SBO, dest_alignment> & dest) const {
+    template <std::size_t dest_SBO, std::size_t dest_alignment, bool dest_pmr, bool dest_layout>
+    void copy_into(storage_for<Trait, dest_SBO, dest_alignment, dest_pmr, dest_layout> & dest) const {
         VX_SOME_LOG("storage_for [NO SBO]");
-        dest.p_trait = (main_trait_t*)p_trait->do_action(detail::opcode::copy_into, (void*)&dest.buffer, {dest_SBO, dest_alignment});
+        if (not p_trait) { return; }
+        auto placed = dest.placement();
+        dest.reset((main_trait_t*)p_trait->do_action(detail::opcode::copy_into, dest.sbo_buffer(), dest.sbo(), &placed, dest.resource()),
+                   placed);
+        dest.mark_trivial_payload(this->payload_is_trivial());
     }
 
     //!@note: Expects the dest to be in a reset state, i.e. the previously occuping object has been destroyed
-    template <std::size_t dest_SBO, std::size_t dest_alignment>
-    void move_into(storage_for<Trait, dest_SBO, dest_alignment> & dest) && noexcept {
-        dest.p_trait = std::exchange(p_trait, nullptr);
+    //!@note: The dest may hold a base of our trait (see detail::narrows_to), the object is then owned through that base
+    template <typename DestTrait, std::size_t dest_SBO, std::size_t dest_alignment, bool dest_pmr, bool dest_layout>
+    void move_into(storage_for<DestTrait, dest_SBO, dest_alignment, dest_pmr, dest_layout> & dest) && noexcept(not pmr && not dest_pmr) {
+        if (not p_trait) { return; }
+        dest.mark_trivial_payload(this->payload_is_trivial());
+        if (detail::same_resource(this->resource(), dest.resource())) {
+            dest.reset(std::exchange(p_trait, nullptr));
+        } else {
+            auto placed = dest.placement();
+            dest.reset(static_cast<main_trait_t*>(p_trait->do_action(detail::opcode::move_into, dest.sbo_buffer(), dest.sbo(), &placed, dest.resource())),
+                       placed);
+        }
     }
+
+    main_trait_t * get() const noexcept { return p_trait; }
+
+    void reset(main_trait_t * p, detail::placement const& = {}) noexcept { p_trait = p; }
+
+    static constexpr bool stored_in_sbo() noexcept { return false; }
+
+    static constexpr cfg::SBO sbo() noexcept { return {0, Alignment}; }
+
+    static constexpr detail::placement placement() noexcept { return {}; }
+
+    constexpr void* sbo_buffer() const noexcept { return nullptr; }
 };
 
 
@@ -806,7 +1545,8 @@ struct storage_for<Trait, 0, Alignment> {
 /// The Trait is an interface an object has to satisfy
 template <typename Trait=vx::trait, cfg::some config=cfg::some{}>
 struct some : basic_operations_for<some<Trait, config>, Trait>,
-              multitrait_support_for<some<Trait, config>, Trait>
+              multitrait_support_for<some<Trait, config>, Trait>,
+              detail::allocator_aware<config.pmr>
 {
     // this one is needed for the CRTP class basic_operations_for<>
     template <typename X> 
@@ -814,6 +1554,18 @@ struct some : basic_operations_for<some<Trait, config>, Trait>,
 
     template <typename T2, cfg::some c2>
     friend struct some;
+
+    template <typename>
+    friend class shared_some;
+
+    template <typename, cfg::fsome>
+    friend struct fsome;
+
+    template <class>
+    friend class poly_view;
+
+    template <typename>
+    friend class type_registry;
         
     
     some() requires(config.empty_state) =default;
@@ -830,6 +1582,15 @@ struct some : basic_operations_for<some<Trait, config>, Trait>,
         static_assert(not config.move || std::is_move_constructible_v<std::remove_cvref_t<T>>,
                       "The object is required to be move constructible by the configuration");
     }
+
+    ///@brief: the T constructed in place out of the args, see emplace()
+    template <typename T, typename... Args>
+    requires (not polymorphic<T> && std::is_constructible_v<T, Args&&...>)
+    explicit some(std::in_place_type_t<T>, Args&&... args) {
+        static_assert(not config.copy || std::is_copy_constructible_v<T>, "The object is required to be copyable by the configuration");
+        static_assert(not config.move || std::is_move_constructible_v<T>, "The object is required to be move constructible by the configuration");
+        storage.template emplace<T>(std::forward<Args>(args)...);
+    }
     
     ~some() = default;
     
@@ -865,18 +1626,88 @@ struct some : basic_operations_for<some<Trait, config>, Trait>,
         return *this;
     }
 
+    ///@brief: replaces the object with a T constructed in place (in the SBO or on the heap) out of the args, no T temporary
+    ///@note: the some<> is left empty if the constructor throws
+    template <typename T, typename... Args>
+    requires (not polymorphic<T> && std::is_constructible_v<T, Args&&...>)
+    T& emplace(Args&&... args) {
+        static_assert(not config.copy || std::is_copy_constructible_v<T>, "The object is required to be copyable by the configuration");
+        static_assert(not config.move || std::is_move_constructible_v<T>, "The object is required to be move constructible by the configuration");
+        storage.clear();
+        storage.template emplace<T>(std::forward<Args>(args)...);
+        return static_cast<impl_type<T>*>(storage.get())->self();
+    }
+
     
+    ///@note: the memory resource (if any) moves along with the object
     template <cfg::some config2>
-    some(some<Trait, config2> && other) noexcept {
+    some(some<Trait, config2> && other) noexcept(not config2.pmr || config.pmr)
+    : storage{other.storage.resource()} {
         std::move(other).storage.move_into(this->storage);
     }
 
+    ///@note: the memory resource (if any) stays, the object is handed over if the resources are the same, moved otherwise
     template <cfg::some config2>
-    some& operator= (some<Trait, config2> && other) noexcept {
+    some& operator= (some<Trait, config2> && other) noexcept(not config.pmr && not config2.pmr) {
         storage.clear();
         std::move(other).storage.move_into(this->storage);
         return *this;
     }
+
+    ///@brief: trait narrowing, takes over the object of a some<mix<Trait, ...>> or of a some<Derived> (see detail::narrows_to),
+    /// which is left empty. The heap-resident object is handed over as is, the one in the SBO is moved.
+    ///@note: the object stays an impl of the original trait(s): try_get<T> doesn't find it through the narrowed some
+    template <typename From, cfg::some config2>
+    requires (detail::narrows_to<From, Trait>)
+    some(some<From, config2> && other) noexcept(not config2.pmr || config.pmr)
+    : storage{other.storage.resource()} {
+        std::move(other).storage.move_into(this->storage);
+    }
+
+    ///@brief: takes over the object of an fsome<> (of the same trait or a narrowed one), which is left empty:
+    /// the heap-resident one is handed over as is, in the impl<From, T> it lives in (see detail::fsome_heap),
+    /// the memory resource (if any) moves along with it. Otherwise the T is moved into an impl<Trait, T> here
+    /// (impl<A, T> for an fsome<mix<A, ...>>), in the SBO if it fits
+    template <typename From, cfg::fsome config2>
+    requires (config2.move && not detail::mixed_traits<Trait>::value 
+              && (std::is_same_v<From, Trait> || detail::narrows_to<From, Trait>))
+    some(fsome<From, config2> && other) : storage{other.resource()} {
+        std::move(other).move_into(this->storage);
+    }
+
+
+    /// ===== [ allocator support, .pmr=true ] =====
+    /// uses-allocator construction, so that pmr containers hand their memory resource down to the elements
+
+    some(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc) noexcept 
+    requires(config.pmr && config.empty_state)
+    : storage{alloc.resource()} {}
+
+    template <typename T>
+    requires (config.pmr && not polymorphic<T>)
+    some(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc, T && obj) 
+    requires ((not config.copy || std::is_copy_constructible_v<std::remove_cvref_t<T>>)
+              &&
+              (not config.move || std::is_move_constructible_v<std::remove_cvref_t<T>>))
+    : storage{alloc.resource(), std::forward<T>(obj)} {}
+
+    template <cfg::some config2>
+    some(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc, some<Trait, config2> const& other) 
+    requires(config.pmr)
+    : storage{alloc.resource()} {
+        other.storage.copy_into(this->storage);
+    }
+
+    template <cfg::some config2>
+    some(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc, some<Trait, config2> && other) 
+    requires(config.pmr)
+    : storage{alloc.resource()} {
+        std::move(other).storage.move_into(this->storage);
+    }
+
+    std::pmr::polymorphic_allocator<> get_allocator() const noexcept requires(config.pmr) {
+        return detail::allocator_from(storage.resource());
+    }
     
 protected:
     friend struct basic_operations_for<some<Trait, config>, Trait>;
@@ -886,17 +1717,17 @@ protected:
         if constexpr (config.check_empty) {
             if (storage.p_trait == nullptr) { throw empty_some_access{"empty some<> accessed"}; }
         } 
-        return storage.p_trait; 
+        return storage.get(); 
     }
     auto* trait_ptr() noexcept(not config.check_empty) { 
         if constexpr (config.check_empty) {
             if (storage.p_trait == nullptr) { throw empty_some_access{"empty some<> accessed"}; }
         }
-        return storage.p_trait; 
+        return storage.get(); 
     }
         
 private:
-    storage_for<Trait, config.sbo.size, config.sbo.alignment> storage;
+    storage_for<Trait, config.sbo.size, config.sbo.alignment, config.pmr, config.relocatable> storage;
 };
 
 
@@ -916,26 +1747,39 @@ struct some<Trait const&> : poly_view<const Trait> { //some_cref<Trait> {
 /// Unlike the `storage` type used in `some`, doesn't know the stored object type
 /// As such, it only allocates, the deallocation is handled in the virtual function 
 /// in `trait::do_action(opcode::cleanup, ...)`
+/// @note: the heap-resident object is allocated in an impl<Trait, T> (see detail::fsome_heap)
 /// @tparam capacity: SBO buffer capacity
 /// @tparam align: max supported type alignment
-template <std::size_t capacity, std::size_t alignment>
-struct fsome_storage_policy {
+/// @tparam pmr: heap allocations are made from a memory resource held by the storage
+template <std::size_t capacity, std::size_t alignment, bool pmr=false>
+struct fsome_storage_policy : detail::resource_holder<pmr> {
 
     template <typename X>
     static constexpr bool is_sbo_eligible = detail::is_sbo_eligible_with<X>(capacity, alignment);
 
     fsome_storage_policy() = default;
 
+    explicit fsome_storage_policy(std::pmr::memory_resource * mr) noexcept : detail::resource_holder<pmr>{mr} {}
+
     void* get_sbo_buffer() noexcept { return &sbo[0]; }
+    const void* get_sbo_buffer() const noexcept { return &sbo[0]; }
 
-    template <typename T, typename X = std::remove_cvref_t<T>>
+    template <typename Trait, typename T, typename X = std::remove_cvref_t<T>>
     auto make(T && obj) {
+        return make_in_place<Trait, X>(std::forward<T>(obj));
+    }
+
+    /// the X constructed right in its placement, out of the args
+    template <typename Trait, typename X, typename... Args>
+    auto make_in_place(Args&&... args) {
+        this->mark_trivial_payload(std::is_trivially_destructible_v<X>);
         if constexpr (is_sbo_eligible<X>) {
             using Deleter = decltype([](X * p){ p->~X(); });
-            return std::unique_ptr<X, Deleter>(new(&sbo) X(std::forward<T>(obj)));
+            return std::unique_ptr<X, Deleter>(new(&sbo) X(std::forward<Args>(args)...));
         } else {
-            return std::make_unique<X>(obj);
-            // return new X(std::forward<T>(obj));
+            using heap = detail::fsome_heap<Trait, X>;
+            return std::unique_ptr<X, typename heap::deleter>(
+                heap::make(this->resource(), std::forward<Args>(args)...), {this->resource()});
         }
     }
 
@@ -943,16 +1787,25 @@ private:
     alignas(alignment) std::byte sbo[capacity];
 };
 
-template <std::size_t alignment>
-struct fsome_storage_policy<0, alignment> {
+template <std::size_t alignment, bool pmr>
+struct fsome_storage_policy<0, alignment, pmr> : detail::resource_holder<pmr> {
     fsome_storage_policy() = default;
 
+    explicit fsome_storage_policy(std::pmr::memory_resource * mr) noexcept : detail::resource_holder<pmr>{mr} {}
+
     constexpr void* get_sbo_buffer() const noexcept { return nullptr; }
 
-    template <typename T, typename X = std::remove_cvref_t<T>>
+    template <typename Trait, typename T, typename X = std::remove_cvref_t<T>>
     auto make(T && obj) {
-        // return new X(std::forward<T>(obj));
-        return std::make_unique<X>(std::forward<T>(obj));
+        return make_in_place<Trait, X>(std::forward<T>(obj));
+    }
+
+    template <typename Trait, typename X, typename... Args>
+    auto make_in_place(Args&&... args) {
+        this->mark_trivial_payload(std::is_trivially_destructible_v<X>);
+        using heap = detail::fsome_heap<Trait, X>;
+        return std::unique_ptr<X, typename heap::deleter>(
+            heap::make(this->resource(), std::forward<Args>(args)...), {this->resource()});
     }
 };
 
@@ -964,19 +1817,31 @@ struct fsome_storage_policy<0, alignment> {
 ///   will keep a vptr inside the polymorphic object, which can be on the heap.
 /// - The second point should be obvoius by now.
 template <typename Trait=vx::trait, vx::cfg::fsome config = vx::cfg::fsome{}>
-struct fsome : public fsome_storage_policy<config.sbo.size, config.sbo.alignment>,
-               public basic_operations_for<fsome<Trait, config>, Trait> {
+struct fsome : public fsome_storage_policy<config.sbo.size, config.sbo.alignment, config.pmr>,
+               public basic_operations_for<fsome<Trait, config>, Trait>,
+               public detail::allocator_aware<config.pmr> {
     
     template <typename, vx::cfg::fsome>
     friend struct fsome;
 
+    template <typename, vx::cfg::some>
+    friend struct some;
+
+    template <typename>
+    friend class type_registry;
+
+    template <typename, vx::cfg::fsome>
+    friend class soa_vector;
+
     /// @brief This one is needed for the `basic_operations_for` CRTP to work
     /// It converts the type X into the actual wrapped type impl<Trait, T> but here's a catch:
     /// It's not always exactly T :)
     template <typename X> 
     using impl_type = some_ptr<Trait, config.check_empty>::template impl_type<X>;
 
-    using storage_policy = fsome_storage_policy<config.sbo.size, config.sbo.alignment>;
+    using storage_policy = fsome_storage_policy<config.sbo.size, config.sbo.alignment, config.pmr>;
+
+    using raw_trait_t = std::remove_cv_t<Trait>;
 
 
     fsome() requires(config.empty_state) =default;
@@ -988,16 +1853,28 @@ struct fsome : public fsome_storage_policy<config.sbo.size, config.sbo.alignment
                              (not config.copy || std::is_copy_constructible_v<std::remove_cvref_t<T>>)
                              &&
                              (not config.move || std::is_move_constructible_v<std::remove_cvref_t<T>>))
-    : poly_{ this->make(std::forward<T>(obj)) }
+    : poly_{ this->template make<raw_trait_t>(std::forward<T>(obj)) }
     {
+        remember_if_relocatable<std::remove_cvref_t<T>>();
         static_assert(not config.copy || std::is_copy_constructible_v<std::remove_cvref_t<T>>,
                       "The object is required to be copyable by the configuration");
         static_assert(not config.move || std::is_move_constructible_v<std::remove_cvref_t<T>>,
                       "The object is required to be move constructible by the configuration");
     }
+
+    ///@brief: the T constructed in place out of the args, see emplace()
+    template <typename T, typename... Args>
+    requires (not polymorphic<T> && std::is_constructible_v<T, Args&&...>)
+    explicit fsome(std::in_place_type_t<T>, Args&&... args)
+    : poly_{ this->template make_in_place<raw_trait_t, T>(std::forward<Args>(args)...) }
+    {
+        remember_if_relocatable<T>();
+        static_assert(not config.copy || std::is_copy_constructible_v<T>, "The object is required to be copyable by the configuration");
+        static_assert(not config.move || std::is_move_constructible_v<T>, "The object is required to be move constructible by the configuration");
+    }
     
 
-    fsome(fsome const& other) : poly_{}
+    fsome(fsome const& other) : storage_policy{}, poly_{}
     {
         VX_SOME_LOG(__PRETTY_FUNCTION__);
         other.copy_into(*this);
@@ -1005,7 +1882,7 @@ struct fsome : public fsome_storage_policy<config.sbo.size, config.sbo.alignment
 
 
     template <cfg::fsome other_config>
-    fsome(fsome<Trait, other_config> const& other) : poly_{}
+    fsome(fsome<Trait, other_config> const& other) : storage_policy{}, poly_{}
     {
         VX_SOME_LOG(__PRETTY_FUNCTION__);
         other.copy_into(*this);
@@ -1048,21 +1925,84 @@ struct fsome : public fsome_storage_policy<config.sbo.size, config.sbo.alignment
                                          &&
                                          (not config.move || std::is_move_constructible_v<std::remove_cvref_t<T>>)) {
         clear();
-        poly_ = this->make(std::forward<T>(obj));
+        poly_ = this->template make<raw_trait_t>(std::forward<T>(obj));
+        remember_if_relocatable<std::remove_cvref_t<T>>();
         return *this;
     }
+
+    ///@brief: replaces the object with a T constructed in place (in the SBO or on the heap) out of the args, no T temporary
+    ///@note: the fsome<> is left empty if the constructor throws
+    template <typename T, typename... Args>
+    requires (not polymorphic<T> && std::is_constructible_v<T, Args&&...>)
+    T& emplace(Args&&... args) {
+        static_assert(not config.copy || std::is_copy_constructible_v<T>, "The object is required to be copyable by the configuration");
+        static_assert(not config.move || std::is_move_constructible_v<T>, "The object is required to be move constructible by the configuration");
+        clear();
+        poly_.forget();
+        auto object = this->template make_in_place<raw_trait_t, T>(std::forward<Args>(args)...);
+        T & result = *object;
+        poly_ = std::move(object);
+        remember_if_relocatable<T>();
+        return result;
+    }
     
-    fsome(fsome && other) noexcept : poly_{} {
+    ///@note: the memory resource (if any) moves along with the object
+    fsome(fsome && other) noexcept : storage_policy{other.resource()}, poly_{} {
         std::move(other).move_into(*this);
     }
 
     template <cfg::fsome other_config>
-    fsome(fsome<Trait, other_config> && other) noexcept : poly_{} 
+    fsome(fsome<Trait, other_config> && other) noexcept(not other_config.pmr || config.pmr) 
+    : storage_policy{other.resource()}, poly_{} 
     {
         std::move(other).move_into(*this);
     }
 
 
+    ///@brief: takes over the object of a some<>, which is left empty: the heap-resident one is handed over as is,
+    /// in the impl<Trait, T> it lives in (see detail::fsome_heap), the memory resource (if any) moves along with it.
+    /// The T is moved out of its impl<Trait, T> into this fsome's SBO or heap placement if it's in the some's SBO
+    /// or if the resources differ (only one side is pmr), and so is a narrowed one
+    /// (the impl<A, T*> of the some<mix<A, ...>>'s first trait, see detail::narrows_to)
+    ///@note: a pointer-like object (a smart pointer) can't go into an fsome (its impl<Trait, T*> would call the smart pointer,
+    /// not its pointee): vx::bad_some_conversion is thrown and the some keeps it
+    template <typename From, cfg::some other_config>
+    requires (other_config.move && not detail::mixed_traits<Trait>::value
+              && (std::is_same_v<From, Trait> || (detail::narrows_to<From, Trait> && sizeof(first_trait_from<From>) == sizeof(Trait))))
+    fsome(some<From, other_config> && other) : storage_policy{other.storage.resource()}, poly_{} {
+        auto & storage = other.storage;
+        if (storage.get() == nullptr) { return; }
+        this->mark_trivial_payload(storage.payload_is_trivial());
+        if constexpr (std::is_same_v<From, Trait>) {
+            if (not storage.stored_in_sbo() && detail::same_resource(storage.resource(), this->resource())
+                && storage.get()->do_action(detail::opcode::hand_over_block, nullptr, {}, (void*)&poly_.iface)) {
+                storage.p_trait = nullptr;
+                return;
+            }
+        }
+        storage.get()->do_action(
+            detail::opcode::fsome_move_sbo_into, this->get_sbo_buffer(), config.sbo, (void*)&poly_.iface, this->resource());
+        if (poly_.empty()) { throw bad_some_conversion{"a pointer-like object can't be moved into an fsome<>"}; }
+        storage.clear();
+    }
+
+    ///@brief: trait narrowing, takes over the object of an fsome<Derived> (see detail::narrows_to), which is left empty:
+    /// the impl<Derived, T*> is kept inline as is (the same {vptr, dptr} layout), a heap-resident T isn't touched
+    template <typename From, cfg::fsome other_config>
+    requires (detail::narrows_to<From, Trait> && not detail::mixed_traits<From>::value && sizeof(From) == sizeof(Trait))
+    fsome(fsome<From, other_config> && other) : storage_policy{other.resource()}, poly_{} {
+        if (other.poly_.empty()) { return; }
+        this->mark_trivial_payload(other.payload_is_trivial());
+        if (other.data() == other.get_sbo_buffer() || not detail::same_resource(other.resource(), this->resource())) {
+            other.poly_->do_action(
+                detail::opcode::fsome_move_sbo_into, this->get_sbo_buffer(), config.sbo, (void*)&poly_.iface, this->resource());
+            other.clear();
+        } else {
+            std::memcpy(&poly_.iface, &other.poly_.iface, sizeof(poly_.iface));
+        }
+        other.poly_.forget();
+    }
+
     template <cfg::fsome other_config>
     fsome& operator= (fsome<Trait, other_config> && other)
     {
@@ -1075,9 +2015,57 @@ struct fsome : public fsome_storage_policy<config.sbo.size, config.sbo.alignment
         return *this;
     }
     
+
+    /// ===== [ allocator support, .pmr=true ] =====
+    /// uses-allocator construction, so that pmr containers hand their memory resource down to the elements
+
+    fsome(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc) noexcept
+    requires(config.pmr && config.empty_state)
+    : storage_policy{alloc.resource()}, poly_{} {}
+
+    template <typename T>
+    fsome(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc, T && obj) 
+    requires (config.pmr
+              &&
+              not polymorphic<T>
+              &&
+              (not config.copy || std::is_copy_constructible_v<std::remove_cvref_t<T>>)
+              &&
+              (not config.move || std::is_move_constructible_v<std::remove_cvref_t<T>>))
+    : storage_policy{alloc.resource()}, poly_{ this->template make<raw_trait_t>(std::forward<T>(obj)) } {
+        remember_if_relocatable<std::remove_cvref_t<T>>();
+    }
+
+    template <cfg::fsome other_config>
+    fsome(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc, fsome<Trait, other_config> const& other)
+    requires(config.pmr)
+    : storage_policy{alloc.resource()}, poly_{} {
+        other.copy_into(*this);
+    }
+
+    template <cfg::fsome other_config>
+    fsome(std::allocator_arg_t, std::pmr::polymorphic_allocator<> const& alloc, fsome<Trait, other_config> && other)
+    requires(config.pmr)
+    : storage_policy{alloc.resource()}, poly_{} {
+        std::move(other).move_into(*this);
+    }
+
+    std::pmr::polymorphic_allocator<> get_allocator() const noexcept requires(config.pmr) {
+        return detail::allocator_from(this->resource());
+    }
+
+    /// the vptr of the impl<Trait, T*> kept inline in the fsome, read without touching the object:
+    /// fsomes holding the same type T have the same vptr, empty ones have a nullptr
+    const void* vptr() const noexcept { return poly_.inspect().vptr; }
+
+    /// the address of the T (in the SBO buffer or on the heap), nullptr for an empty fsome
+    const void* data() const noexcept { return poly_.inspect().dptr; }
+    
     ~fsome() {
         /// cleanup will check to see it the pointer == get_sbo_buffer, if so it's in SBO, otherwise, on the heap.
-        if (not poly_.empty()) { poly_->do_action(detail::opcode::cleanup, this->get_sbo_buffer(), {0,0}); }
+        if (poly_.empty()) { return; }
+        if (skips_release()) { poly_.forget(); return; }
+        poly_->do_action(detail::opcode::cleanup, this->get_sbo_buffer(), {0,0}, nullptr, this->resource());
     }
 
 protected:
@@ -1090,7 +2078,27 @@ protected:
         if constexpr (config.empty_state) {
             if (poly_.empty()) { return; }
         }
-        poly_->do_action(detail::opcode::cleanup, this->get_sbo_buffer(), config.sbo);
+        if (skips_release()) { poly_.forget(); return; }
+        poly_->do_action(detail::opcode::cleanup, this->get_sbo_buffer(), config.sbo, nullptr, this->resource());
+    }
+
+    /// trivially destructible payload in the SBO buffer or in the current arena: can be simply forgotten
+    bool skips_release() const noexcept {
+        return storage_policy::skips_release(poly_.inspect().dptr == this->get_sbo_buffer());
+    }
+
+    /// the SBO-resident payload is known to be trivially relocatable (see detail::relocatable_vptrs)
+    bool payload_relocatable() const noexcept {
+        return detail::relocatable_vptrs<Trait*>::contains(poly_.inspect().vptr);
+    }
+
+    template <typename X>
+    void remember_if_relocatable() noexcept {
+        if constexpr (config.sbo.size > 0) {
+            if constexpr (storage_policy::template is_sbo_eligible<X> && vx::is_trivially_relocatable_v<X>) {
+                detail::remember_relocatable<Trait*, impl_type<X>>(&poly_.iface);
+            }
+        }
     }
 
     template <cfg::fsome other_config>
@@ -1101,12 +2109,23 @@ protected:
         // passes the &other.poly_.iface along so the actual thing can be placement-new-constructed in there directly
         // the some_ptr class uses the std::launder anyway to stop the TBAA from intervening, so should work
         const_cast<fsome&>(*this)->do_action(
-            detail::opcode::copy_into, other.get_sbo_buffer(), other_config.sbo, (void*)&other.poly_.iface);
+            detail::opcode::copy_into, other.get_sbo_buffer(), other_config.sbo, (void*)&other.poly_.iface, other.resource());
+        other.mark_trivial_payload(this->payload_is_trivial());
     }
 
     template <cfg::fsome other_config>
-    void move_into(fsome<Trait, other_config> & other) && noexcept
+    void move_into(fsome<Trait, other_config> & other) && noexcept(not config.pmr && not other_config.pmr)
     {
+        other.mark_trivial_payload(this->payload_is_trivial());
+        if constexpr (config.pmr || other_config.pmr) {
+            if (not detail::same_resource(this->resource(), other.resource())) {
+                // the object cannot be handed over to a different memory resource, so it's moved into a new home
+                if (poly_.empty()) { return; }
+                poly_->do_action(detail::opcode::fsome_move_sbo_into, 
+                    other.get_sbo_buffer(), other_config.sbo, (void*)&other.poly_.iface, other.resource());
+                return;
+            }
+        }
         if constexpr (config.sbo.size == 0) { 
             // No SBO even possible, runtime branch unnecessary
 #if VX_FSOME_ELIDE_VCALL_ON_MOVE
@@ -1126,8 +2145,16 @@ protected:
                 if constexpr (config.empty_state) {
                     if (poly_.empty()) { return; }
                 }
+                if constexpr (other_config.sbo.size >= config.sbo.size && other_config.sbo.alignment >= config.sbo.alignment) {
+                    if (payload_relocatable()) {
+                        // trivially relocatable: the bytes are copied over and the data pointer is fixed up
+                        std::memcpy(other.get_sbo_buffer(), this->get_sbo_buffer(), config.sbo.size);
+                        other.poly_.relocate_from(this->poly_, other.get_sbo_buffer());
+                        return;
+                    }
+                }
                 poly_->do_action(detail::opcode::fsome_move_sbo_into, 
-                    other.get_sbo_buffer(), other_config.sbo, (void*)&other.poly_.iface);
+                    other.get_sbo_buffer(), other_config.sbo, (void*)&other.poly_.iface, other.resource());
             } else {
                 // Stored on the heap, so a quick representation swap will do.
                 // `this` will be left in an empty state
@@ -1147,12 +2174,42 @@ protected:
         }
     }
 
+    /// fsome -> some<>, see some(fsome&&): `this` is left empty, the heap-resident object goes to the `dest` in its impl<Trait, T>
+    /// (see detail::fsome_heap) if the memory resource is the same, otherwise the object is moved into an impl<Trait, T> there
+    template <typename DestTrait, std::size_t dest_SBO, std::size_t dest_alignment, bool dest_pmr, bool dest_layout>
+    void move_into(storage_for<DestTrait, dest_SBO, dest_alignment, dest_pmr, dest_layout> & dest) && {
+        if (poly_.empty()) { return; }
+        if (data() != this->get_sbo_buffer() && detail::same_resource(this->resource(), dest.resource())) {
+            if (auto * block = static_cast<first_trait_from<Trait>*>(poly_->do_action(detail::opcode::hand_over_block, nullptr, {}))) {
+                dest.reset(block);
+                dest.mark_trivial_payload(this->payload_is_trivial());
+                poly_.forget();
+                return;
+            }
+        }
+        auto placed = dest.placement();
+        dest.reset(static_cast<first_trait_from<Trait>*>(
+            poly_->do_action(detail::opcode::move_into, dest.sbo_buffer(), dest.sbo(), &placed, dest.resource())), placed);
+        dest.mark_trivial_payload(this->payload_is_trivial());
+        clear();
+        poly_.forget();
+    }
+
 private:
     some_ptr<Trait, config.check_empty> poly_{}; // {vptr + data_ptr} 
     // using Layout = struct { void* vptr; void* dptr; };
 };
 
 
+/// some<> with no pointers into itself: either the relocatable layout or no SBO at all
+template <typename Trait, cfg::some config>
+struct is_trivially_relocatable<some<Trait, config>> : std::bool_constant<config.relocatable || config.sbo.size == 0> {};
+
+/// fsome<> with no SBO is a {vptr, dptr} pair pointing to the heap
+template <typename Trait, cfg::fsome config>
+struct is_trivially_relocatable<fsome<Trait, config>> : std::bool_constant<config.sbo.size == 0> {};
+
+
 /// ===== [ IMPL specializations ] =====
 ///@brief: Default do-nothing trait
 template <typename T>
@@ -1161,15 +2218,31 @@ struct impl<vx::trait, T> : vx::impl_for<vx::trait, T> {
 };
 
 ///@brief: Support for mixed traits:
+///@note: every trait in the mix brings its own `trait::do_action`, so the mixed impl overrides it 
+///       once for all of them, copying/moving/disposing of the whole mixed object
 template <typename Trait, typename... Traits, typename T>
 requires (sizeof...(Traits) > 1)
 struct impl<mix<Trait,Traits...>, T> : public impl<mix<Traits...>, impl<Trait, T>> {
     using impl<mix<Traits...>, impl<Trait, T>>::impl;
+
+protected:
+    void* do_action(detail::opcode op, void* buffer, cfg::SBO sbo, void* extra=nullptr, std::pmr::memory_resource* mr=nullptr) override {
+        return this->template do_action_as<impl, Trait>(op, buffer, sbo, extra, mr);
+    }
+
+    const void* type_token() const noexcept override { return &detail::type_key<impl>; }
 };
 
 template <typename Trait1, typename Trait2, typename T>
 struct impl<mix<Trait1, Trait2>, T> : impl<Trait1, impl<Trait2, T>> {
     using impl<Trait1, impl<Trait2, T>>::impl;
+
+protected:
+    void* do_action(detail::opcode op, void* buffer, cfg::SBO sbo, void* extra=nullptr, std::pmr::memory_resource* mr=nullptr) override {
+        return this->template do_action_as<impl, Trait1>(op, buffer, sbo, extra, mr);
+    }
+
+    const void* type_token() const noexcept override { return &detail::type_key<impl>; }
 };
 
 template <typename Trait1, typename Trait2, typename T>
@@ -1259,6 +2332,77 @@ const T* some_cast (const vx::polymorphic auto * obj) noexcept {
 }
 
 
+/// ===== [ Speculative devirtualization ] =====
+/// likely_counter: how often the speculation of visit_likely was right
+///@note: counted with a relaxed load and store, not a locked increment, so that it's cheap enough for the hot loops:
+///       can be shared by the threads, but then some of the counts get lost
+struct likely_counter {
+    std::atomic<std::size_t> hits {0};
+    std::atomic<std::size_t> misses {0};
+
+    double hit_rate() const noexcept {
+        auto const h = hits.load(std::memory_order_relaxed);
+        auto const total = h + misses.load(std::memory_order_relaxed);
+        return total ? static_cast<double>(h) / static_cast<double>(total) : 0.0;
+    }
+
+    void reset() noexcept {
+        hits.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+    }
+
+    static void count(std::atomic<std::size_t> & n) noexcept {
+        n.store(n.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+namespace detail {
+template <typename Object, typename F, typename T, typename... Ts>
+decltype(auto) visit_likely_step(Object & obj, F & f, likely_counter * counter) {
+    auto * iface = &*obj;
+    using impl_t = typename std::remove_const_t<Object>::template impl_type<T>;
+    using qualified_impl_t = std::conditional_t<std::is_const_v<std::remove_pointer_t<decltype(iface)>>, impl_t const, impl_t>;
+    if (auto * impl = impl_cast<qualified_impl_t>(iface)) {
+        if (counter) { counter->count(counter->hits); }
+        return f(*impl);
+    }
+    if constexpr (sizeof...(Ts) > 0) {
+        return visit_likely_step<Object, F, Ts...>(obj, f, counter);
+    } else {
+        if (counter) { counter->count(counter->misses); }
+        return f(*iface);
+    }
+}
+}// namespace detail
+
+/// visit_likely<T1, T2...>(obj, f): bets on the object being one of the Ts, checked in order by the vptr (see try_get).
+/// On a hit f gets the impl<Trait, T>&, the calls on it are direct (and inlined) if the impl is `final`,
+/// on a miss it gets the Trait& and the calls are virtual, so f has to take both (auto&) and return the same type for both.
+/// The optional counter keeps track of the hits and misses, to check that the bet pays off.
+///@note: for some<> and fsome<>, the obj must not be empty
+template <typename... Ts, typename Object, typename F>
+requires (sizeof...(Ts) > 0 && polymorphic<Object>)
+decltype(auto) visit_likely(Object & obj, F && f, likely_counter * counter = nullptr) {
+    return detail::visit_likely_step<Object, F, Ts...>(obj, f, counter);
+}
+
+/// likely<T1, T2...>(obj): the visit_likely as an adapter, `vx::likely<Circle>(shape) ->* [](auto & s) { return s.area(); }`
+template <typename Object, typename... Ts>
+struct likely_ref {
+    Object & object;
+    likely_counter * counter = nullptr;
+
+    template <typename F>
+    decltype(auto) operator->* (F && f) const { return visit_likely<Ts...>(object, std::forward<F>(f), counter); }
+};
+
+template <typename... Ts, typename Object>
+requires (sizeof...(Ts) > 0 && polymorphic<Object>)
+likely_ref<Object, Ts...> likely(Object & obj, likely_counter * counter = nullptr) noexcept {
+    return {obj, counter};
+}
+
+
 
 } // namespace vx
 
@@ -0,0 +1,203 @@
+// Copyright (C) Alexander Vaskov 2025
+// (See accompanying file LICENSE.md)
+
+#pragma once
+
+#include <algorithm> // max
+#include <cstddef> // byte, size_t
+#include <memory> // construct_at, destroy_at
+#include <new> // launder
+#include <tuple> // tuple_element_t
+#include <type_traits>
+#include <utility> // forward, move
+
+#include "some.hpp"
+
+namespace vx {
+
+template <typename Trait, typename... Ts>
+class some_of;
+
+namespace detail {
+    template <typename Trait, typename... Ts>
+    struct is_polymorphic< some_of<Trait, Ts...> > : std::true_type {};
+}// namespace detail
+
+
+/// ===== [ SOME OF ] =====
+///@brief: A polymorphic object of one of the listed types, a closed set: the impl<Trait, T> is stored inline
+/// in a buffer sized for the largest of them, next to the index of its type. Never allocates.
+/// The same impl<Trait, T> as with some<> are used, so the trait code doesn't change.
+/// - `->` and `*` are calls through the vtable of the inline object (no pointer chasing, the object is right there)
+/// - visit(f) switches over the type index and calls `f(impl<Trait, T>&)`: the calls on a final impl are direct
+///   and can be inlined, that's the fast path for the hot loops
+/// - copy, move and destruction are switches too, the do_action isn't used
+///@note: an empty some_of (default constructed, or after a throwing assignment) throws empty_some_access on visit
+template <typename Trait, typename... Ts>
+class some_of : public basic_operations_for<some_of<Trait, Ts...>, Trait>,
+                public multitrait_support_for<some_of<Trait, Ts...>, Trait> {
+    static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) < 255, "some_of needs 1 to 254 types");
+    static_assert((std::is_same_v<Ts, std::remove_cvref_t<Ts>> && ...), "some_of holds the object types themselves");
+
+    using main_trait_t = first_trait_from<Trait>;
+
+    static constexpr std::size_t n_types = sizeof...(Ts);
+    static constexpr std::size_t capacity = std::max({sizeof(vx::impl<Trait, Ts>)...});
+    static constexpr std::size_t alignment = std::max({alignof(vx::impl<Trait, Ts>)...});
+    static constexpr u8 npos = 255;
+
+    template <std::size_t I>
+    using type_at = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+public:
+    template <typename X>
+    using impl_type = vx::impl< Trait, std::remove_cvref_t<X> >;
+
+    template <typename X>
+    static constexpr bool holds_type = (std::is_same_v<std::remove_cvref_t<X>, Ts> || ...);
+
+    some_of() noexcept = default;
+
+    template <typename T>
+    requires (holds_type<T>)
+    some_of(T && obj) {
+        emplace(std::forward<T>(obj));
+    }
+
+    some_of(some_of const& other) requires (std::is_copy_constructible_v<Ts> && ...) {
+        if (other.empty()) { return; }
+        dispatch(other, [this](auto const& impl) { emplace(impl.self()); });
+    }
+
+    some_of(some_of && other) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...))
+    requires (std::is_move_constructible_v<Ts> && ...) {
+        if (other.empty()) { return; }
+        dispatch(other, [this](auto & impl) { emplace(std::move(impl.self())); });
+    }
+
+    some_of& operator= (some_of const& other) requires (std::is_copy_constructible_v<Ts> && ...) {
+        if (this == &other) { return *this; }
+        clear();
+        if (not other.empty()) { dispatch(other, [this](auto const& impl) { emplace(impl.self()); }); }
+        return *this;
+    }
+
+    some_of& operator= (some_of && other) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...))
+    requires (std::is_move_constructible_v<Ts> && ...) {
+        if (this == &other) { return *this; }
+        clear();
+        if (not other.empty()) { dispatch(other, [this](auto & impl) { emplace(std::move(impl.self())); }); }
+        return *this;
+    }
+
+    template <typename T>
+    requires (holds_type<T>)
+    some_of& operator= (T && obj) {
+        clear();
+        emplace(std::forward<T>(obj));
+        return *this;
+    }
+
+    ~some_of() { clear(); }
+
+    /// f(impl<Trait, T>&) for the stored T, the type is picked with a switch
+    template <typename F>
+    decltype(auto) visit(F && f) {
+        if (empty()) [[unlikely]] { throw empty_some_access{"empty some_of<> visited"}; }
+        return dispatch(*this, std::forward<F>(f));
+    }
+
+    template <typename F>
+    decltype(auto) visit(F && f) const {
+        if (empty()) [[unlikely]] { throw empty_some_access{"empty some_of<> visited"}; }
+        return dispatch(*this, std::forward<F>(f));
+    }
+
+    /// the position of the stored type in the Ts..., or sizeof...(Ts) if empty
+    std::size_t index() const noexcept { return empty() ? n_types : index_; }
+
+    bool empty() const noexcept { return index_ == npos; }
+
+    template <typename Target>
+    Target* try_get() noexcept {
+        if constexpr (holds_type<Target>) {
+            return index_ == detail::index_in<Target, Ts...> ? &impl_at<detail::index_in<Target, Ts...>>().self() : nullptr;
+        } else {
+            return nullptr;
+        }
+    }
+
+    template <typename Target>
+    const Target* try_get() const noexcept {
+        return const_cast<some_of&>(*this).template try_get<std::remove_const_t<Target>>();
+    }
+
+protected:
+    friend struct basic_operations_for<some_of<Trait, Ts...>, Trait>;
+    friend struct multitrait_support_for<some_of<Trait, Ts...>, Trait>;
+
+    main_trait_t * trait_ptr() noexcept {
+        return empty() ? nullptr : std::launder(reinterpret_cast<main_trait_t*>(buffer_ + trait_offset_));
+    }
+
+    main_trait_t const* trait_ptr() const noexcept {
+        return empty() ? nullptr : std::launder(reinterpret_cast<main_trait_t const*>(buffer_ + trait_offset_));
+    }
+
+private:
+    template <std::size_t I>
+    vx::impl<Trait, type_at<I>> & impl_at() noexcept {
+        return *std::launder(reinterpret_cast<vx::impl<Trait, type_at<I>>*>(buffer_));
+    }
+
+    template <std::size_t I>
+    static constexpr std::size_t clamp = I < n_types ? I : n_types - 1;
+
+    /// a switch over the index, 8 types at a time (the out of range cases are never taken)
+    template <std::size_t Base = 0, typename Self, typename F>
+    static decltype(auto) dispatch(Self & self, F && f) {
+        auto & s = const_cast<some_of&>(self);
+        switch (self.index_ - Base) {
+            case 0: return f(constness_of<Self>(s.template impl_at<clamp<Base + 0>>()));
+            case 1: return f(constness_of<Self>(s.template impl_at<clamp<Base + 1>>()));
+            case 2: return f(constness_of<Self>(s.template impl_at<clamp<Base + 2>>()));
+            case 3: return f(constness_of<Self>(s.template impl_at<clamp<Base + 3>>()));
+            case 4: return f(constness_of<Self>(s.template impl_at<clamp<Base + 4>>()));
+            case 5: return f(constness_of<Self>(s.template impl_at<clamp<Base + 5>>()));
+            case 6: return f(constness_of<Self>(s.template impl_at<clamp<Base + 6>>()));
+            case 7: return f(constness_of<Self>(s.template impl_at<clamp<Base + 7>>()));
+            default:
+                if constexpr (Base + 8 < n_types) {
+                    return dispatch<Base + 8>(self, std::forward<F>(f));
+                } else {
+                    return f(constness_of<Self>(s.template impl_at<n_types - 1>()));
+                }
+        }
+    }
+
+    /// the impl with the constness of the some_of
+    template <typename Self, typename Impl>
+    static auto & constness_of(Impl & impl) noexcept {
+        if constexpr (std::is_const_v<Self>) { return std::as_const(impl); } else { return impl; }
+    }
+
+    template <typename T>
+    void emplace(T && obj) {
+        using impl_t = impl_type<T>;
+        auto * impl = std::construct_at(reinterpret_cast<impl_t*>(buffer_), std::forward<T>(obj));
+        trait_offset_ = static_cast<u16>(reinterpret_cast<std::byte*>(static_cast<main_trait_t*>(impl)) - buffer_);
+        index_ = static_cast<u8>(detail::index_in<std::remove_cvref_t<T>, Ts...>);
+    }
+
+    void clear() noexcept {
+        if (empty()) { return; }
+        dispatch(*this, [](auto & impl) { std::destroy_at(&impl); });
+        index_ = npos;
+    }
+
+    alignas(alignment) std::byte buffer_[capacity];
+    u8 index_ = npos;
+    u16 trait_offset_ = 0; ///< where the main trait subobject starts in the buffer
+};
+
+} // namespace vx
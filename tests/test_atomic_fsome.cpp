@@ -0,0 +1,111 @@
+/// the stress part is meant to be run under -fsanitize=thread as well:
+/// g++ -std=c++20 -fsanitize=thread test_atomic_fsome.cpp -lpthread
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include "../atomic_fsome.hpp"
+
+std::atomic<int> alive {0};
+
+struct Strategy : vx::trait {
+    virtual int route(int key) const noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Strategy, T> final : vx::impl_for<Strategy, T> {
+    using vx::impl_for<Strategy, T>::impl_for;
+    using vx::impl_for<Strategy, T>::self;
+    int route(int key) const noexcept override { return self().route(key); }
+};
+
+/// checks it's not being used after its destruction
+struct Tracked {
+    static constexpr int live = 0x600d, dead = 0xdead;
+    int state = live;
+    Tracked() noexcept { ++alive; }
+    Tracked(Tracked const&) noexcept { ++alive; }
+    ~Tracked() { state = dead; --alive; }
+    void check() const noexcept { assert(( state == live )); }
+};
+
+struct Modulo {
+    int buckets = 1;
+    Tracked tracked {};
+    int route(int key) const noexcept { tracked.check(); return key % buckets; }
+};
+
+struct Table {
+    std::array<int, 16> table {};
+    Tracked tracked {};
+    explicit Table(int offset) { for (int i = 0; i < 16; ++i) { table[i] = i + offset; } }
+    int route(int key) const noexcept { tracked.check(); return table[key % 16]; }
+};
+
+template <vx::cfg::fsome config>
+void stress() {
+    constexpr int n_readers = 4;
+    constexpr int n_stores = 2000;
+    {
+        vx::atomic_fsome<Strategy, config> strategy {Modulo{1}};
+        std::atomic<bool> done {false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < n_readers; ++t) {
+            readers.emplace_back([&, t] {
+                unsigned sum = 0;
+                while (not done.load(std::memory_order_relaxed)) {
+                    sum += strategy->route(t);
+                    auto pinned = strategy.load(); // a few calls to the same object
+                    sum += pinned->route(t) + pinned->route(t + 1);
+                    std::this_thread::yield();
+                }
+                assert(( sum > 0 ));
+            });
+        }
+        for (int i = 0; i < n_stores; ++i) {
+            if (i % 2) { strategy.store(Modulo{i}); } else { strategy = Table{i}; }
+            std::this_thread::yield(); // lets the readers in between the stores
+        }
+        done = true;
+        for (auto & r : readers) { r.join(); }
+        strategy.reclaim();
+        assert(( strategy.retired() == 0 && alive == 1 ));
+    }
+    assert(( alive == 0 ));
+}
+
+int main() {
+    /// Load, store and the guards
+    {
+        vx::atomic_fsome<Strategy> strategy {Modulo{10}};
+        assert(( strategy->route(42) == 2 ));
+        {
+            auto pinned = strategy.load();
+            strategy.store(Table{100});
+            assert(( pinned->route(42) == 2 && strategy->route(1) == 101 )); // the old one is still alive
+            assert(( strategy.retired() == 1 && pinned.try_get<Modulo>() != nullptr ));
+        }
+        strategy.reclaim();
+        assert(( strategy.retired() == 0 && alive == 1 ));
+
+        vx::atomic_fsome<Strategy> empty;
+        assert(( not empty.load() ));
+    }
+    assert(( alive == 0 ));
+
+    /// Too many guards on a thread
+    {
+        vx::atomic_fsome<Strategy> strategy {Modulo{3}};
+        std::vector<vx::atomic_fsome<Strategy>::guard> guards;
+        bool thrown = false;
+        try {
+            for (int i = 0; i < 10; ++i) { guards.push_back(strategy.load()); }
+        } catch (vx::hazard_slots_exhausted const&) { thrown = true; }
+        assert(( thrown && guards.size() == vx::detail::hazard_record::n_slots ));
+    }
+
+    /// Readers calling while the strategy is swapped
+    stress<vx::cfg::fsome{}>();
+    stress<vx::cfg::fsome{.sbo{80}}>(); // the objects live in the nodes
+}
@@ -0,0 +1,105 @@
+#include <cassert>
+#include <list>
+#include <string>
+#include <vector>
+#include "../batched.hpp"
+
+struct Shape : vx::trait {
+    virtual int info() const noexcept = 0;
+    virtual void bump() noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> : vx::impl_for<Shape, T> {
+    using impl_for<Shape, T>::impl_for;
+    using impl_for<Shape, T>::self;
+
+    int info() const noexcept override { return self().info(); }
+    void bump() noexcept override { self().bump(); }
+};
+
+struct Square {
+    int side = 0;
+    int info() const noexcept { return side; }
+    void bump() noexcept { ++side; }
+};
+
+struct Circle {
+    int radius = 0;
+    int info() const noexcept { return radius; }
+    void bump() noexcept { --radius; }
+};
+
+struct Label {
+    std::string text;
+    int info() const noexcept { return static_cast<int>(text.size()); }
+    void bump() noexcept { text += '!'; }
+};
+
+int main() {
+    std::vector<vx::fsome<Shape>> shapes;
+    for (int i = 0; i < 30; ++i) {
+        switch (i % 3) {
+            case 0: shapes.emplace_back(Square{i}); break;
+            case 1: shapes.emplace_back(Circle{i}); break;
+            case 2: shapes.emplace_back(Label{std::string(i, 'x')}); break;
+        }
+    }
+    shapes.emplace_back(); // empty, left out
+    shapes.emplace_back(Square{100});
+
+    /// vptrs identify the types
+    assert(( shapes[0].vptr() == shapes[3].vptr() ));
+    assert(( shapes[0].vptr() != shapes[1].vptr() ));
+    assert(( shapes[30].vptr() == nullptr ));
+
+    /// Grouping: in the order the types are first seen, stable within a group
+    {
+        auto groups = vx::group_by_type(shapes);
+        assert(( groups.size() == 3 ));
+        assert(( groups[0].vptr == shapes[0].vptr() && groups[0].items.size() == 11 ));
+        assert(( groups[1].vptr == shapes[1].vptr() && groups[1].items.size() == 10 ));
+        assert(( groups[2].items.size() == 10 ));
+
+        int previous = -1;
+        for (auto it : groups[0].items) {
+            assert(( (*it)->info() > previous ));
+            previous = (*it)->info();
+        }
+        assert(( previous == 100 ));
+
+        std::size_t total = 0;
+        for (auto const& [vptr, items] : groups) {
+            for (auto it : items) { assert(( it->vptr() == vptr )); }
+            total += items.size();
+        }
+        assert(( total == 31 ));
+
+        /// reusing the groups
+        int visited = 0;
+        vx::for_each_batched(groups, [&](auto & shape) { shape->bump(); ++visited; });
+        assert(( visited == 31 ));
+        assert(( shapes[0]->info() == 1 && shapes[1]->info() == 0 && shapes[2]->info() == 3 ));
+    }
+
+    /// Batched calls, type by type
+    {
+        std::vector<const void*> order;
+        vx::for_each_batched(shapes, [&](vx::fsome<Shape> const& shape) { order.push_back(shape.vptr()); });
+        assert(( order.size() == 31 ));
+        std::size_t switches = 0;
+        for (std::size_t i = 1; i < order.size(); ++i) { switches += order[i] != order[i-1]; }
+        assert(( switches == 2 ));
+    }
+
+    /// Any forward range will do, const included
+    {
+        std::list<vx::fsome<Shape>> const list {Square{1}, Circle{2}, Square{3}};
+        int sum = 0;
+        vx::for_each_batched(list, [&](auto const& shape) { sum = sum * 10 + shape->info(); });
+        assert(( sum == 132 ));
+
+        std::vector<vx::fsome<Shape>> none;
+        assert(( vx::group_by_type(none).size() == 0 ));
+    }
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <cassert>
+#include <vector>
+#include "../cow_some.hpp"
+
+unsigned count_copies = 0;
+
+struct State : vx::trait {
+    virtual int value() const noexcept = 0;
+    virtual void add(int n) noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<State, T> final : vx::impl_for<State, T> {
+    using vx::impl_for<State, T>::impl_for;
+    using vx::impl_for<State, T>::self;
+    int value() const noexcept override { return self().value; }
+    void add(int n) noexcept override { self().value += n; }
+};
+
+/// big enough for a clone to hurt (like the Object of test_some.cpp)
+struct Board {
+    int value = 0;
+    std::array<int, 100> cells {};
+    Board(int v) : value{v} {}
+    Board(Board const& other) : value{other.value}, cells{other.cells} { ++count_copies; }
+};
+
+struct Counter {
+    int value = 0;
+};
+
+int main() {
+    /// Copies share the object until it's changed
+    {
+        vx::cow_some<State> a {Board{1}};
+        count_copies = 0;
+        auto b = a;
+        auto const& cb = b;
+        assert(( cb->value() == 1 && a.use_count() == 2 && count_copies == 0 ));
+        assert(( cb.try_get<Board>() == std::as_const(a).try_get<Board>() )); // the same object
+
+        b->add(1); // the first non-const access clones
+        assert(( count_copies == 1 && a.use_count() == 1 && b.use_count() == 1 ));
+        assert(( std::as_const(a)->value() == 1 && std::as_const(b)->value() == 2 ));
+
+        b->add(1); // unique, no more clones
+        a->add(10);
+        assert(( count_copies == 1 && std::as_const(b)->value() == 3 && std::as_const(a)->value() == 11 ));
+
+        (*a).add(1);
+        assert(( a.try_get<Board>()->value == 12 && count_copies == 1 ));
+    }
+
+    /// A snapshot history: only the changed states are cloned
+    {
+        std::vector<vx::cow_some<State>> history {vx::cow_some<State>{Board{0}}};
+        count_copies = 0;
+        for (int step = 1; step <= 10; ++step) {
+            history.push_back(history.back());
+            if (step % 5 == 0) { history.back()->add(step); }
+        }
+        assert(( count_copies == 2 ));
+        assert(( std::as_const(history[4])->value() == 0 && std::as_const(history[5])->value() == 5 ));
+        assert(( std::as_const(history[10])->value() == 15 && history[10].use_count() == 1 ));
+    }
+
+    /// From an rvalue some, small and unshared objects
+    {
+        vx::some<State> s {Counter{5}};
+        vx::cow_some<State> c {std::move(s)};
+        auto copy = c;
+        copy->add(1);
+        assert(( std::as_const(c)->value() == 5 && std::as_const(copy)->value() == 6 ));
+        assert(( c.try_get<Counter>() != nullptr && c.try_get<Board>() == nullptr ));
+
+        vx::cow_some<State> empty;
+        assert(( not empty && not c.try_get<Board>() ));
+    }
+}
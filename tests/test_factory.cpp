@@ -0,0 +1,154 @@
+#include <cassert>
+#include <string>
+#include <vector>
+#include "../factory.hpp"
+
+struct Handler : vx::trait {
+    virtual std::string handle(std::string const& input) const = 0;
+};
+
+template <typename T>
+struct vx::impl<Handler, T> final : vx::impl_for<Handler, T> {
+    using vx::impl_for<Handler, T>::impl_for;
+    using vx::impl_for<Handler, T>::self;
+    std::string handle(std::string const& input) const override { return self().handle(input); }
+};
+
+struct Config {
+    std::string prefix;
+    int repeat = 1;
+};
+
+unsigned copies = 0, moves = 0;
+
+struct Counted {
+    Counted() = default;
+    Counted(Counted const&) { ++copies; }
+    Counted(Counted &&) noexcept { ++moves; }
+};
+
+struct Echo : Counted {
+    std::string handle(std::string const& input) const { return input; }
+};
+
+struct Prefix : Counted {
+    std::string prefix;
+    explicit Prefix(Config const& config) : prefix{config.prefix} {}
+    std::string handle(std::string const& input) const { return prefix + input; }
+};
+
+struct Repeat : Counted {
+    int times;
+    std::string prefix;
+    explicit Repeat(Config const& config) : times{config.repeat}, prefix{config.prefix} {}
+    Repeat(int n, std::string p) : times{n}, prefix{std::move(p)} {}
+    std::string handle(std::string const& input) const {
+        std::string out = prefix;
+        for (int i = 0; i < times; ++i) { out += input; }
+        return out;
+    }
+};
+
+/// doesn't pull the impl_for constructors in: made out of a moved T
+struct Quiet : vx::trait {
+    virtual int level() const noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Quiet, T> final : vx::impl_for<Quiet, T> {
+    template <typename U> requires std::convertible_to<U&&, T>
+    explicit impl(U && object) : vx::impl_for<Quiet, T>{std::forward<U>(object)} {}
+    int level() const noexcept override { return this->self().level; }
+};
+
+struct Level : Counted {
+    int level;
+    explicit Level(int l) : level{l} {}
+};
+
+using handlers = vx::factory<Handler,
+    vx::named<"echo", Echo>,
+    vx::named<"prefix", Prefix>,
+    vx::named<"repeat", Repeat>
+>;
+
+int main() {
+    /// Lookup
+    {
+        static_assert( handlers::size() == 3 );
+        static_assert( handlers::index_of("prefix") == 1 && handlers::index_of("repeat") == 2 );
+        static_assert( handlers::contains("echo") && not handlers::contains("ech") && not handlers::contains("") );
+        assert(( handlers::names()[2] == "repeat" ));
+        assert(( not handlers::contains(std::string{"echo!"}) ));
+    }
+
+    /// Made in place: no copy, no move of the T
+    {
+        Config const config {"> ", 2};
+        copies = moves = 0;
+        vx::some<Handler> echo = handlers::make("echo");
+        auto prefix = handlers::make<vx::some<Handler>>("prefix", config);
+        auto repeat = handlers::make<vx::fsome<Handler>>("repeat", config);
+        assert(( echo->handle("a") == "a" && prefix->handle("a") == "> a" && repeat->handle("ab") == "> abab" ));
+
+        vx::fsome<Handler, vx::cfg::fsome{.sbo{64}}> in_sbo;
+        handlers::make_into(in_sbo, "repeat", 3, std::string{"#"});
+        assert(( in_sbo->handle("x") == "#xxx" && in_sbo.data() == in_sbo.get_sbo_buffer() ));
+
+        std::vector<vx::some<Handler>> table(4);
+        std::string const names[] = {"repeat", "prefix", "repeat", "prefix"};
+        for (std::size_t i = 0; i < table.size(); ++i) { handlers::make_into(table[i], names[i], config); }
+        assert(( table[3]->handle("b") == "> b" ));
+        assert(( copies == 0 && moves == 0 ));
+    }
+
+    /// emplace and in_place_type construction
+    {
+        copies = moves = 0;
+        vx::some<Handler> some {std::in_place_type<Repeat>, 2, "-"};
+        vx::fsome<Handler> fsome {std::in_place_type<Prefix>, Config{"+"}};
+        assert(( some->handle("o") == "-oo" && fsome->handle("o") == "+o" ));
+        auto & echo = some.emplace<Echo>();
+        assert(( some->handle("o") == "o" && some.try_get<Echo>() == &echo ));
+        auto & repeat = fsome.emplace<Repeat>(1, "*");
+        assert(( fsome->handle("o") == "*o" && repeat.times == 1 ));
+        assert(( copies == 0 && moves == 0 ));
+
+        vx::some<Handler, vx::cfg::some{.sbo{0}}> heap {std::in_place_type<Prefix>, Config{"h"}};
+        assert(( heap->handle("i") == "hi" ));
+    }
+
+    /// An impl without the impl_for constructors gets the T moved in
+    {
+        copies = moves = 0;
+        vx::some<Quiet> quiet;
+        quiet.emplace<Level>(3);
+        assert(( quiet->level() == 3 && copies == 0 && moves == 1 ));
+    }
+
+    /// Errors
+    {
+        vx::some<Handler> target;
+        bool thrown = false;
+        try { handlers::make_into(target, "unknown"); } catch (vx::factory_error const&) { thrown = true; }
+        assert(( thrown ));
+        thrown = false;
+        try { handlers::make_into(target, "prefix"); } catch (vx::factory_error const&) { thrown = true; } // needs a Config
+        assert(( thrown ));
+    }
+
+    /// A bigger table
+    {
+        using many = vx::factory<Handler,
+            vx::named<"a", Echo>, vx::named<"b", Echo>, vx::named<"c", Echo>, vx::named<"d", Echo>,
+            vx::named<"ab", Echo>, vx::named<"ba", Echo>, vx::named<"abc", Echo>, vx::named<"cba", Echo>,
+            vx::named<"handler.echo", Echo>, vx::named<"handler.echo2", Echo>, vx::named<"handler.echo3", Echo>,
+            vx::named<"x", Echo>, vx::named<"y", Echo>, vx::named<"z", Echo>, vx::named<"zz", Echo>, vx::named<"zzz", Echo>,
+            vx::named<"", Echo>
+        >;
+        for (std::size_t i = 0; i < many::size(); ++i) {
+            assert(( many::index_of(many::names()[i]) == i ));
+        }
+        assert(( not many::contains("handler.echo4") && not many::contains("zzzz") ));
+    }
+}
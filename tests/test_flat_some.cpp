@@ -0,0 +1,123 @@
+#include <cassert>
+#include <string>
+#include <vector>
+#include "../flat_some.hpp"
+
+struct Named : vx::trait {
+    virtual std::string name() const = 0;
+};
+
+struct Sized : vx::trait {
+    virtual std::size_t size() const noexcept = 0;
+};
+
+struct Growable : vx::trait {
+    virtual void grow() = 0;
+};
+
+template <typename T>
+struct vx::impl<Named, T> : vx::impl_for<Named, T> {
+    using vx::impl_for<Named, T>::impl_for;
+    std::string name() const override { return vx::poly{this}->name(); }
+};
+
+template <typename T>
+struct vx::impl<Sized, T> : vx::impl_for<Sized, T> {
+    using vx::impl_for<Sized, T>::impl_for;
+    std::size_t size() const noexcept override { return vx::poly{this}->size(); }
+};
+
+template <typename T>
+struct vx::impl<Growable, T> : vx::impl_for<Growable, T> {
+    using vx::impl_for<Growable, T>::impl_for;
+    void grow() override { vx::poly{this}->grow(); }
+};
+
+struct Counter {
+    std::size_t n = 0;
+    std::string name() const { return "counter"; }
+    std::size_t size() const noexcept { return n; }
+    void grow() { ++n; }
+};
+
+struct Text {
+    std::string text;
+    std::string name() const { return "text:" + text; }
+    std::size_t size() const noexcept { return text.size(); }
+    void grow() { text += text.empty() ? "x" : text.substr(0, 1); }
+};
+
+using Traits = vx::mix<Named, Sized, Growable>;
+
+int main() {
+    /// One vptr, whatever the number of traits
+    {
+        using flat = vx::flat_some<Traits, vx::cfg::fsome{.sbo{8, 8}}>;
+        static_assert( sizeof(flat) == sizeof(Counter) + 3 * sizeof(void*) );
+        // the some<> holds impl<mix, T>: a vptr per trait next to the T, plus the pointer to it
+        static_assert( sizeof(vx::impl<Traits, Counter>) == sizeof(Counter) + 3 * sizeof(void*) );
+        static_assert( sizeof(vx::some<Traits, vx::cfg::some{.sbo{32, 8}}>) == sizeof(flat) + sizeof(void*) );
+    }
+
+    /// Calling the traits
+    {
+        vx::flat_some<Traits> counter {Counter{2}};
+        assert(( counter->name() == "counter" ));
+        assert(( counter.as<Sized>()->size() == 2 ));
+        counter.as<Growable>()->grow();
+        assert(( counter.as<Sized>()->size() == 3 && counter.try_get<Counter>()->n == 3 ));
+        assert(( counter.as<Named>()->name() == "counter" && counter.try_get<Text>() == nullptr ));
+
+        auto const& view = counter;
+        assert(( view.as<Sized>()->size() == 3 && (*view).name() == "counter" ));
+        static_assert( std::is_same_v<decltype(view.as<Sized>().get()), Sized const*> );
+    }
+
+    /// Copying and moving, in the SBO and on the heap
+    {
+        using flat = vx::flat_some<Traits, vx::cfg::fsome{.sbo{16}}>;
+        std::vector<flat> objects;
+        objects.emplace_back(Counter{1});
+        objects.emplace_back(Text{std::string(40, 'a')}); // doesn't fit the SBO
+        objects.emplace_back(Counter{5});
+        for (int i = 0; i < 10; ++i) { objects.push_back(objects[i % 3]); } // and the reallocations move them
+
+        std::size_t total = 0;
+        for (auto & o : objects) {
+            o.as<Growable>()->grow();
+            total += o.as<Sized>()->size();
+        }
+        assert(( total == 2 + 41 + 6 + 4 * 2 + 3 * 41 + 3 * 6 ));
+        assert(( objects[1]->name() == "text:" + std::string(41, 'a') ));
+
+        flat moved = std::move(objects[2]);
+        assert(( moved.as<Sized>()->size() == 6 && not objects[2] ));
+
+        moved = Text{"b"};
+        assert(( moved->name() == "text:b" && moved.as<Sized>()->size() == 1 ));
+        moved.as<Growable>()->grow();
+        assert(( moved.try_get<Text>()->text == "bb" ));
+    }
+
+    /// Narrowing to the first trait
+    {
+        vx::flat_some<Traits> text {Text{"abc"}};
+        auto const* data = text.try_get<Text>();
+        vx::fsome<Named> named = std::move(text);
+        assert(( named.try_get<Text>() == data && named->name() == "text:abc" && not text ));
+
+        vx::flat_some<Traits> counter {Counter{4}};
+        vx::some<Named> owned = std::move(counter);
+        assert(( owned.try_get<Counter>()->n == 4 ));
+    }
+
+    /// Empty
+    {
+        vx::flat_some<Traits, vx::cfg::fsome{.check_empty = false}> empty;
+        assert(( not empty && not empty.as<Sized>() ));
+        vx::flat_some<Traits, vx::cfg::fsome{.check_empty = true}> checked;
+        bool thrown = false;
+        try { checked.as<Named>(); } catch (vx::empty_some_access const&) { thrown = true; }
+        assert(( thrown ));
+    }
+}
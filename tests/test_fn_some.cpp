@@ -0,0 +1,97 @@
+#include <array>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <string>
+#include "../fn_some.hpp"
+
+int twice(int x) { return 2 * x; }
+
+struct Counter {
+    int count = 0;
+    int operator() (int step) { return count += step; }
+};
+
+int main() {
+    /// Lambdas, function pointers and function objects
+    {
+        vx::fn_some<int(int)> f {[](int x) { return x + 1; }};
+        assert(( f && f(1) == 2 ));
+
+        f = &twice;
+        assert(( f(21) == 42 ));
+
+        f = Counter{};
+        assert(( f(1) == 1 && f(2) == 3 )); // stateful, the target is called as non-const
+
+        vx::fn_some<void(std::string&)> append {[suffix = std::string{"!"}](std::string & s) { s += suffix; }};
+        std::string text = "hi";
+        append(text);
+        assert(( text == "hi!" ));
+
+        vx::fn_some<long(int, int)> converted {[](int a, int b) { return a * b; }}; // int -> long
+        assert(( converted(6, 7) == 42 ));
+    }
+
+    /// Copying and moving
+    {
+        vx::fn_some<int(int)> f {Counter{}};
+        f(10);
+        auto copy = f;
+        assert(( copy(1) == 11 && f(1) == 11 )); // independent copies
+
+        auto moved = std::move(f);
+        assert(( moved(1) == 12 && not f ));
+
+        f = std::move(moved);
+        assert(( f(1) == 13 && not moved ));
+
+        std::array<long, 8> big {1, 2, 3, 4, 5, 6, 7, 8}; // doesn't fit the SBO
+        vx::fn_some<long(int)> g {[big](int i) { return big[i]; }};
+        auto g2 = g;
+        auto g3 = std::move(g);
+        assert(( g2(7) == 8 && g3(0) == 1 && not g ));
+
+        // self-assignment keeps the target
+        auto& self = g2;
+        g2 = self;
+        assert(( g2 && g2(7) == 8 ));
+        g2 = std::move(self);
+        assert(( g2 && g2(6) == 7 ));
+    }
+
+    /// Move-only targets and the empty state
+    {
+        vx::fn_some<int(), vx::cfg::some{.copy=false}> f {[p = std::make_unique<int>(42)] { return *p; }};
+        assert(( f() == 42 ));
+        auto moved = std::move(f);
+        assert(( moved() == 42 ));
+        static_assert(not std::is_copy_constructible_v<decltype(f)> && not std::is_copy_assignable_v<decltype(f)>);
+        static_assert(std::is_copy_constructible_v<vx::fn_some<int()>>);
+
+        vx::fn_some<int(int), vx::cfg::some{.check_empty=false}> empty;
+        assert(( not empty ));
+        bool thrown = false;
+        try { empty(1); } catch (std::bad_function_call const&) { thrown = true; }
+        assert(( thrown ));
+
+        // the check_empty one throws the same
+        vx::fn_some<int(int), vx::cfg::some{.check_empty=true}> checked;
+        thrown = false;
+        try { checked(1); } catch (std::bad_function_call const&) { thrown = true; }
+        assert(( thrown ));
+        auto taken = std::move(checked = [](int x) { return x; });
+        assert(( taken(3) == 3 && not checked ));
+        thrown = false;
+        try { checked(1); } catch (std::bad_function_call const&) { thrown = true; }
+        assert(( thrown ));
+    }
+
+    /// An empty call with the default config
+    {
+        vx::fn_some<void()> empty;
+        bool thrown = false;
+        try { empty(); } catch (std::bad_function_call const&) { thrown = true; }
+        assert(( thrown ));
+    }
+}
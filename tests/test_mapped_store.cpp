@@ -0,0 +1,183 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../mapped_store.hpp"
+
+struct Shape : vx::trait {
+    virtual int area() const noexcept = 0;
+    virtual void scale(int k) noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> final : vx::impl_for<Shape, T> {
+    using vx::impl_for<Shape, T>::impl_for;
+    using vx::impl_for<Shape, T>::self;
+    int area() const noexcept override { return self().area(); }
+    void scale(int k) noexcept override { self().scale(k); }
+};
+
+struct Square {
+    int side = 1;
+    int area() const noexcept { return side * side; }
+    void scale(int k) noexcept { side *= k; }
+};
+
+struct Rect {
+    std::int16_t w = 1, h = 1;
+    int area() const noexcept { return w * h; }
+    void scale(int k) noexcept { w = std::int16_t(w * k); h = std::int16_t(h * k); }
+};
+
+/// needs the 8-byte alignment in the file
+struct Box {
+    double volume = 0;
+    int area() const noexcept { return static_cast<int>(volume); }
+    void scale(int k) noexcept { volume *= k; }
+};
+
+/// can be serialized, but not mapped
+struct Label {
+    std::string text;
+    int area() const noexcept { return static_cast<int>(text.size()); }
+    void scale(int) noexcept {}
+};
+
+template <>
+struct vx::serializer<Label> {
+    static void write(vx::binary_writer & out, Label const& label) { out.write(label.text); }
+    static Label read(vx::binary_reader & in) { return Label{in.read<std::string>()}; }
+};
+
+/// the bytes of a stream, in a buffer aligned the way a mapping would be
+static std::vector<std::max_align_t> aligned_copy(std::string const& bytes) {
+    std::vector<std::max_align_t> buffer((bytes.size() + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+    std::memcpy(buffer.data(), bytes.data(), bytes.size());
+    return buffer;
+}
+
+int main() {
+    vx::type_registry<Shape> registry;
+    registry.add<Square>(1).add<Rect>(2).add<Box>(3).add<Label>(4);
+
+    std::vector<vx::some<Shape>> shapes;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) { shapes.emplace_back(Square{i}); }
+        else if (i % 3 == 1) { shapes.emplace_back(Rect{std::int16_t(i), 2}); }
+        else { shapes.emplace_back(Box{double(i) * 10}); }
+    }
+    std::stringstream stream;
+    vx::binary_writer out {stream};
+    vx::mapped_store<const Shape>::write(out, registry, shapes);
+    auto const bytes = stream.str();
+
+    /// Views straight into the memory
+    {
+        auto buffer = aligned_copy(bytes);
+        std::span<const std::byte> memory {reinterpret_cast<const std::byte*>(buffer.data()), bytes.size()};
+        vx::mapped_store<const Shape> store {memory, registry};
+        assert(( store.size() == shapes.size() ));
+        for (std::size_t i = 0; i < shapes.size(); ++i) {
+            assert(( store[i]->area() == shapes[i]->area() ));
+        }
+        assert(( store.id_of(0) == 1 && store.id_of(1) == 2 && store.id_of(2) == 3 ));
+
+        vx::poly_view<const Shape> view = store.at(2);
+        assert(( view->area() == 20 ));
+        static_assert(std::is_same_v<decltype(store[0]), vx::poly_view<const Shape>>);
+
+        bool thrown = false;
+        try { (void)store.at(shapes.size()); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+    }
+
+    /// Writable views over a private copy
+    {
+        auto buffer = aligned_copy(bytes);
+        std::span<std::byte> memory {reinterpret_cast<std::byte*>(buffer.data()), bytes.size()};
+        vx::mapped_store<Shape> store {memory, registry};
+        store[3]->scale(2);
+        assert(( store[3]->area() == 36 ));
+        vx::mapped_store<const Shape> same {memory, registry}; // the T is the one in the memory, not a copy
+        assert(( same[3]->area() == 36 ));
+        vx::mapped_store<Shape> moved = std::move(store);
+        assert(( moved[3]->area() == 36 && store.size() == 0 ));
+    }
+
+    /// Memory-mapped file
+    {
+        auto const path = "vx_test_mapped_store_" + std::to_string(std::random_device{}()) + ".bin";
+        {
+            std::ofstream file {path, std::ios::binary};
+            vx::binary_writer file_out {file};
+            vx::mapped_store<const Shape>::write(file_out, registry, shapes);
+        }
+        {
+            auto store = vx::mapped_store<const Shape>::open(path, registry);
+            assert(( store.size() == shapes.size() && store[99]->area() == 99 * 99 ));
+            std::size_t total = 0, expected = 0;
+            for (std::size_t i = 0; i < store.size(); ++i) { total += store[i]->area(); expected += shapes[i]->area(); }
+            assert(( total == expected ));
+
+            auto cow = vx::mapped_store<Shape>::open(path, registry); // copy-on-write, the file isn't modified
+            cow[0]->scale(3);
+            assert(( cow[0]->area() == 0 && cow[3]->area() == 9 ));
+            cow[3]->scale(3);
+            assert(( cow[3]->area() == 81 && store[3]->area() == 9 ));
+        }
+        std::remove(path.c_str());
+
+        bool thrown = false;
+        try { (void)vx::mapped_store<const Shape>::open("vx_no_such_file.bin", registry); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+    }
+
+    /// Errors
+    {
+        std::stringstream bad;
+        vx::binary_writer bad_out {bad};
+        bool thrown = false;
+        std::vector<vx::fsome<Shape>> labels;
+        labels.emplace_back(Label{"not trivially copyable"});
+        try { vx::mapped_store<const Shape>::write(bad_out, registry, labels); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+
+        thrown = false;
+        std::vector<vx::some<Shape>> empty(1);
+        try { vx::mapped_store<const Shape>::write(bad_out, registry, empty); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+
+        // the file's types unknown to the registry
+        vx::type_registry<Shape> other;
+        other.add<Square>(1).add<Rect>(2);
+        auto buffer = aligned_copy(bytes);
+        std::span<const std::byte> memory {reinterpret_cast<const std::byte*>(buffer.data()), bytes.size()};
+        thrown = false;
+        try { vx::mapped_store<const Shape> store {memory, other}; } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+
+        // truncated
+        thrown = false;
+        try { vx::mapped_store<const Shape> store {memory.first(memory.size() - 1), registry}; } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+    }
+
+    /// fsome<> sources write the same file
+    {
+        std::vector<vx::fsome<Shape>> fshapes;
+        for (int i = 0; i < 100; ++i) {
+            if (i % 3 == 0) { fshapes.emplace_back(Square{i}); }
+            else if (i % 3 == 1) { fshapes.emplace_back(Rect{std::int16_t(i), 2}); }
+            else { fshapes.emplace_back(Box{double(i) * 10}); }
+        }
+        std::stringstream fstream;
+        vx::binary_writer fout {fstream};
+        vx::mapped_store<const Shape>::write(fout, registry, fshapes);
+        assert(( fstream.str() == bytes ));
+    }
+}
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../parallel.hpp"
+
+struct Shape : vx::trait {
+    virtual int area() const noexcept = 0;
+    virtual void grow() noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> final : vx::impl_for<Shape, T> {
+    using vx::impl_for<Shape, T>::impl_for;
+    using vx::impl_for<Shape, T>::self;
+    int area() const noexcept override { return self().area(); }
+    void grow() noexcept override { self().grow(); }
+};
+
+struct Square {
+    int side = 1;
+    int area() const noexcept { return side * side; }
+    void grow() noexcept { ++side; }
+};
+
+struct Rect {
+    int w = 1, h = 2;
+    int area() const noexcept { return w * h; }
+    void grow() noexcept { ++w; }
+};
+
+struct Label {
+    std::string text;
+    int area() const noexcept { return static_cast<int>(text.size()); }
+    void grow() noexcept { text += '!'; }
+};
+
+template <typename Vector>
+static Vector make_shapes(int n) {
+    Vector shapes;
+    for (int i = 0; i < n; ++i) {
+        switch (i % 3) {
+            case 0: shapes.emplace_back(Square{i % 7}); break;
+            case 1: shapes.emplace_back(Rect{i % 5, 2}); break;
+            case 2: shapes.emplace_back(Label{std::string(std::size_t(i % 11), 'x')}); break;
+        }
+    }
+    return shapes;
+}
+
+template <typename Range>
+static long sequential_area(Range const& shapes) {
+    long total = 0;
+    for (auto const& shape : shapes) { total += shape->area(); }
+    return total;
+}
+
+int main() {
+    vx::thread_pool pool {4};
+    assert(( pool.concurrency() == 4 ));
+
+    /// Every index exactly once, on more than one thread
+    {
+        std::vector<std::atomic<int>> hits(10'000);
+        pool.run(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+        for (auto const& hit : hits) { assert(( hit.load() == 1 )); }
+
+        pool.run(0, [](std::size_t) { assert(( false )); });
+        int once = 0;
+        pool.run(1, [&](std::size_t) { ++once; });
+        assert(( once == 1 ));
+
+        vx::thread_pool single {1};
+        std::size_t sum = 0; // no other thread
+        single.run(100, [&](std::size_t i) { sum += i; });
+        assert(( sum == 4950 ));
+    }
+
+    /// Nested runs go on the calling thread, exceptions come out of run()
+    {
+        std::atomic<int> inner {0};
+        pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { ++inner; }); });
+        assert(( inner == 64 ));
+
+        bool thrown = false;
+        try {
+            pool.run(1000, [](std::size_t i) { if (i == 500) { throw std::runtime_error{"500"}; } });
+        } catch (std::runtime_error const& e) { thrown = std::string{e.what()} == "500"; }
+        assert(( thrown ));
+
+        std::atomic<int> after {0}; // still usable
+        pool.run(100, [&](std::size_t) { ++after; });
+        assert(( after == 100 ));
+    }
+
+    /// some<> and fsome<> ranges: the const ones only give access to the const methods
+    {
+        auto somes = make_shapes<std::vector<vx::some<Shape>>>(5000);
+        auto fsomes = make_shapes<std::vector<vx::fsome<Shape>>>(5000);
+        long const expected = sequential_area(somes);
+
+        auto area = [](auto const& shape) { return long{shape->area()}; };
+        assert(( vx::parallel_transform_reduce(pool, std::as_const(somes), 0L, std::plus{}, area) == expected ));
+        assert(( vx::parallel_transform_reduce(pool, std::as_const(fsomes), 0L, std::plus{}, area) == expected ));
+        assert(( vx::parallel_transform_reduce(std::as_const(somes), 0L, std::plus{}, area) == expected )); // the shared pool
+
+        vx::parallel_for_each(pool, std::as_const(fsomes), [](auto & shape) {
+            static_assert(std::is_const_v<std::remove_reference_t<decltype(shape)>>);
+            static_assert(std::is_same_v<decltype(shape.operator->()), Shape const*>);
+        });
+
+        vx::parallel_for_each(pool, somes, [](vx::some<Shape> & shape) { shape->grow(); });
+        vx::parallel_for_each(pool, fsomes, [](vx::fsome<Shape> & shape) { shape->grow(); });
+        assert(( sequential_area(somes) == sequential_area(fsomes) && sequential_area(somes) > expected ));
+
+        std::vector<vx::some<Shape>> none;
+        assert(( vx::parallel_transform_reduce(pool, none, 7L, std::plus{}, area) == 7 ));
+    }
+
+    /// Chunks of one type with type_groups: the calls go type by type
+    {
+        auto fsomes = make_shapes<std::vector<vx::fsome<Shape>>>(3 * 64);
+        vx::thread_pool sequential {1};
+        std::vector<const void*> order;
+        vx::parallel_for_each(sequential, vx::group_by_type(fsomes), [&](auto const& shape) { order.push_back(shape.vptr()); });
+        assert(( order.size() == fsomes.size() ));
+        std::size_t switches = 0;
+        for (std::size_t i = 1; i < order.size(); ++i) { switches += order[i] != order[i - 1]; }
+        assert(( switches == 2 ));
+    }
+
+    /// Pre-grouped: the chunks are the pieces of the type groups, the empty fsomes are left out
+    {
+        auto fsomes = make_shapes<std::vector<vx::fsome<Shape>>>(3000);
+        long const expected = sequential_area(fsomes);
+        fsomes.emplace_back();
+        auto const groups = vx::group_by_type(std::as_const(fsomes));
+        std::atomic<int> mixed {0};
+        vx::parallel_for_each(pool, groups, [&](auto const& shape) { mixed += shape.vptr() == nullptr; });
+        assert(( mixed == 0 ));
+        auto area = [](auto const& shape) { return long{shape->area()}; };
+        assert(( vx::parallel_transform_reduce(pool, groups, 0L, std::plus{}, area) == expected ));
+    }
+
+    /// poly_vector and poly_collection
+    {
+        vx::poly_vector<Shape> vector;
+        vx::poly_collection<Shape> collection;
+        long expected = 0;
+        for (int i = 0; i < 4000; ++i) {
+            if (i % 2) { vector.push_back(Square{i % 9}); collection.insert(Square{i % 9}); expected += (i % 9) * (i % 9); }
+            else { vector.push_back(Rect{i % 4, 3}); collection.insert(Rect{i % 4, 3}); expected += (i % 4) * 3; }
+        }
+        auto area = [](Shape const& shape) { return long{shape.area()}; };
+        assert(( vx::parallel_transform_reduce(pool, std::as_const(vector), 0L, std::plus{}, area) == expected ));
+        assert(( vx::parallel_transform_reduce(pool, std::as_const(collection), 0L, std::plus{}, area) == expected ));
+
+        // f(T&) for the listed types, f(Trait&) for the rest
+        std::atomic<int> typed {0}, virtual_calls {0};
+        vx::parallel_for_each<Square>(pool, collection, [&]<typename T>(T & item) {
+            if constexpr (std::is_same_v<T, Square>) { ++typed; item.grow(); }
+            else { ++virtual_calls; item.grow(); }
+        });
+        assert(( typed == 2000 && virtual_calls == 2000 ));
+        auto const typed_area = vx::parallel_transform_reduce<Square, Rect>(pool, std::as_const(collection), 0L, std::plus{},
+                                                                             [](auto const& item) { return long{item.area()}; });
+        long grown = 0;
+        collection.for_each([&](Shape const& shape) { grown += shape.area(); });
+        assert(( typed_area == grown && grown > expected ));
+
+        vx::parallel_for_each(pool, vector, [](Shape & shape) { shape.grow(); });
+        collection.clear();
+        assert(( vx::parallel_transform_reduce(pool, collection, 0L, std::plus{}, area) == 0 ));
+    }
+}
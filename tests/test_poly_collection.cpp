@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <string>
+#include <vector>
+#include "../poly_collection.hpp"
+
+struct Shape : vx::trait {
+    virtual int info() const noexcept = 0;
+    virtual void bump() noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> : vx::impl_for<Shape, T> {
+    using impl_for<Shape, T>::impl_for;
+    using impl_for<Shape, T>::self;
+
+    int info() const noexcept override { return self().info(); }
+    void bump() noexcept override { self().bump(); }
+};
+
+struct Square {
+    int side = 0;
+    int info() const noexcept { return side; }
+    void bump() noexcept { ++side; }
+};
+
+struct Circle {
+    int radius = 0;
+    int info() const noexcept { return radius; }
+    void bump() noexcept { --radius; }
+};
+
+struct Label {
+    std::string text;
+    int info() const noexcept { return static_cast<int>(text.size()); }
+    void bump() noexcept { text += '!'; }
+};
+
+int main() {
+    vx::poly_collection<Shape> shapes;
+    assert(( shapes.empty() ));
+
+    for (int i = 0; i < 10; ++i) {
+        shapes.emplace<Square>(i);
+        shapes.insert(Circle{i});
+    }
+    auto & label = shapes.insert(Label{"abc"});
+    assert(( label.text == "abc" ));
+    assert(( shapes.size() == 21 ));
+    assert(( shapes.size<Square>() == 10 && shapes.size<Label>() == 1 ));
+    assert(( shapes.segment<Circle>()[3].radius == 3 ));
+    assert(( shapes.segment<int>().empty() ));
+
+    /// Segments are contiguous
+    auto squares = shapes.segment<Square>();
+    for (std::size_t i = 1; i < squares.size(); ++i) {
+        assert(( &squares[i] == &squares[i-1] + 1 ));
+    }
+
+    /// The listed types are visited directly, the rest through Trait&
+    {
+        int direct = 0;
+        int generic = 0;
+        shapes.for_each<Square, Circle>([&](auto & shape) {
+            if constexpr (std::is_base_of_v<Shape, std::remove_cvref_t<decltype(shape)>>) {
+                ++generic;
+            } else {
+                ++direct;
+            }
+            shape.bump();
+        });
+        assert(( direct == 20 && generic == 1 ));
+        assert(( label.text == "abc!" ));
+        assert(( shapes.segment<Square>()[0].side == 1 && shapes.segment<Circle>()[0].radius == -1 ));
+    }
+
+    /// Only through Trait&
+    {
+        int total = 0;
+        std::as_const(shapes).for_each([&](Shape const& shape) { total += shape.info(); });
+        // squares: 1..10, circles: -1..8, label: 4
+        assert(( total == 55 + 35 + 4 ));
+    }
+
+    /// Generic iteration, by segment, then by insertion
+    {
+        std::vector<int> seen;
+        for (vx::some<Shape&> shape : shapes) {
+            seen.push_back(shape->info());
+        }
+        assert(( seen.size() == 21 ));
+        assert(( seen[0] == 1 && seen[10] == -1 && seen[20] == 4 ));
+
+        int total = 0;
+        for (auto it = shapes.cbegin(); it != shapes.cend(); ++it) { total += (*it)->info(); }
+        assert(( total == 55 + 35 + 4 ));
+    }
+
+    /// transform: the batch form for a segment of the listed types, one call per element otherwise
+    {
+        struct info_op {
+            int batches = 0;
+            int operator()(Shape const& shape) const { return shape.info(); }
+            void operator()(std::span<Square const> squares, std::span<int> out) {
+                ++batches;
+                for (std::size_t i = 0; i < squares.size(); ++i) { out[i] = squares[i].side; }
+            }
+        };
+        std::vector<int> expected;
+        for (vx::some<Shape&> shape : shapes) { expected.push_back(shape->info()); }
+
+        info_op op;
+        std::vector<int> infos(shapes.size());
+        shapes.transform<Square, Circle>(std::span{infos}, op);
+        assert(( infos == expected && op.batches == 1 ));
+
+        infos.assign(shapes.size(), 0);
+        shapes.transform(std::span{infos}, op); // not listed: per element
+        assert(( infos == expected && op.batches == 1 ));
+
+        std::vector<long> longs(shapes.size()); // op(T const&) for a listed type without the batch form
+        shapes.transform<Circle>(std::span{longs}, [](auto const& shape) {
+            if constexpr (std::is_same_v<decltype(shape), Circle const&>) { return long{shape.radius}; }
+            else { return long{shape.info()}; }
+        });
+        assert(( std::equal(longs.begin(), longs.end(), expected.begin()) ));
+    }
+
+    /// Moving and clearing
+    {
+        vx::poly_collection<Shape> moved {std::move(shapes)};
+        assert(( moved.size() == 21 ));
+        moved.clear();
+        assert(( moved.empty() && moved.begin() == moved.end() ));
+        moved.emplace<Circle>(5);
+        assert(( moved.size() == 1 && (*moved.begin())->info() == 5 ));
+    }
+}
@@ -0,0 +1,149 @@
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include "../poly_vector.hpp"
+
+struct Shape : vx::trait {
+    virtual int info() const noexcept = 0;
+    virtual void bump() noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> : vx::impl_for<Shape, T> {
+    using impl_for<Shape, T>::impl_for;
+    using impl_for<Shape, T>::self;
+
+    int info() const noexcept override { return self().info(); }
+    void bump() noexcept override { self().bump(); }
+};
+
+int alive = 0;
+
+struct Square {
+    int side = 0;
+    Square(int s) : side{s} { ++alive; }
+    Square(Square && other) noexcept : side{other.side} { ++alive; }
+    ~Square() { --alive; }
+    int info() const noexcept { return side; }
+    void bump() noexcept { ++side; }
+};
+
+struct Label { // non-trivial, heap-owning payload
+    std::string text;
+    int info() const noexcept { return static_cast<int>(text.size()); }
+    void bump() noexcept { text += '!'; }
+};
+
+struct alignas(64) Wide {
+    std::array<int, 20> values {};
+    int info() const noexcept { return values[0]; }
+    void bump() noexcept { ++values[0]; }
+};
+
+struct Pair { // counts its moves
+    static inline int moves = 0;
+    int first = 0, second = 0;
+    Pair(int a, int b) : first{a}, second{b} {}
+    Pair(Pair && other) noexcept : first{other.first}, second{other.second} { ++moves; }
+    int info() const noexcept { return first + second; }
+    void bump() noexcept { ++first; }
+};
+
+int total(vx::poly_vector<Shape> const& shapes) {
+    int sum = 0;
+    for (auto const& shape : shapes) { sum += shape.info(); }
+    return sum;
+}
+
+int main() {
+    /// Basic usage, growth and relocation
+    {
+        vx::poly_vector<Shape> shapes;
+        assert(( shapes.empty() ));
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 2 == 0) {
+                auto & square = shapes.emplace_back<Square>(i);
+                assert(( square.side == i ));
+            } else {
+                shapes.emplace_back<Label>(std::string(i % 7, 'x'));
+            }
+        }
+        assert(( shapes.size() == 1000 ));
+        assert(( alive == 500 ));
+        assert(( shapes[0].info() == 0 && shapes[2].info() == 2 && shapes[3].info() == 3 ));
+
+        int expected = 0;
+        for (int i = 0; i < 1000; ++i) { expected += i % 2 == 0 ? i : i % 7; }
+        assert(( total(shapes) == expected ));
+
+        for (auto & shape : shapes) { shape.bump(); }
+        assert(( total(shapes) == expected + 1000 ));
+
+        shapes.push_back(Label{"hello"});
+        assert(( shapes.back().info() == 5 ));
+    }
+    assert(( alive == 0 ));
+
+    /// Erase and reclaiming the holes
+    {
+        vx::poly_vector<Shape> shapes;
+        shapes.emplace_back<Square>(1);
+        shapes.emplace_back<Label>("ab");
+        shapes.emplace_back<Square>(3);
+
+        auto next = shapes.erase(shapes.begin());
+        assert(( next->info() == 2 ));
+        assert(( shapes.size() == 2 && alive == 1 ));
+        assert(( shapes.front().info() == 2 && shapes.back().info() == 3 ));
+
+        next = shapes.erase(++shapes.begin()); // the last one
+        assert(( next == shapes.end() ));
+        assert(( alive == 0 ));
+
+        auto const capacity = shapes.capacity_bytes();
+        for (int i = 0; i < 10'000; ++i) {
+            shapes.emplace_back<Square>(i);
+            shapes.erase(++shapes.begin());
+        }
+        assert(( shapes.size() == 1 && shapes.front().info() == 2 ));
+        assert(( shapes.capacity_bytes() == capacity )); // erasing the back reuses the space
+
+        for (int i = 0; i < 100; ++i) { shapes.emplace_back<Square>(i); }
+        while (shapes.size() > 1) { shapes.erase(shapes.begin()); } // holes at the front
+        shapes.reserve_bytes(shapes.capacity_bytes()); // relocation packs the survivors together
+        assert(( shapes.size() == 1 && shapes.front().info() == 99 ));
+        assert(( alive == 1 ));
+    }
+    assert(( alive == 0 ));
+
+    /// Over-aligned objects and moving the whole container
+    {
+        vx::poly_vector<Shape> shapes;
+        shapes.emplace_back<Square>(7);
+        shapes.emplace_back<Wide>();
+        shapes.emplace_back<Square>(8);
+        for (auto & shape : shapes) {
+            assert(( reinterpret_cast<std::uintptr_t>(&shape) % 8 == 0 ));
+        }
+        assert(( reinterpret_cast<std::uintptr_t>(&shapes[1]) % 64 == 0 ));
+        shapes[1].bump();
+        assert(( total(shapes) == 16 ));
+
+        vx::poly_vector<Shape> moved {std::move(shapes)};
+        assert(( shapes.empty() && moved.size() == 3 ));
+        assert(( total(moved) == 16 ));
+
+        shapes = std::move(moved);
+        assert(( total(shapes) == 16 && alive == 2 ));
+        shapes.clear();
+        assert(( shapes.empty() && alive == 0 ));
+    }
+
+    /// In-place construction: no temporary moved in
+    {
+        vx::poly_vector<Shape> shapes;
+        shapes.emplace_back<Pair>(1, 2);
+        assert(( Pair::moves == 0 && shapes.front().info() == 3 ));
+    }
+}
@@ -0,0 +1,275 @@
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../serialization.hpp"
+
+struct Shape : vx::trait {
+    virtual int area() const noexcept = 0;
+    virtual std::string name() const = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> final : vx::impl_for<Shape, T> {
+    using vx::impl_for<Shape, T>::impl_for;
+    using vx::impl_for<Shape, T>::self;
+    int area() const noexcept override { return self().area(); }
+    std::string name() const override { return self().name(); }
+};
+
+struct Square {
+    int side = 1;
+    int area() const noexcept { return side * side; }
+    std::string name() const { return "square"; }
+};
+
+struct Rect {
+    std::int16_t w = 1, h = 1;
+    int area() const noexcept { return w * h; }
+    std::string name() const { return "rect"; }
+};
+
+/// not trivially copyable: goes through its own serializer
+struct Label {
+    std::string text;
+    int area() const noexcept { return static_cast<int>(text.size()); }
+    std::string name() const { return "label:" + text; }
+};
+
+template <>
+struct vx::serializer<Label> {
+    static void write(vx::binary_writer & out, Label const& label) { out.write(label.text); }
+    static Label read(vx::binary_reader & in) { return Label{in.read<std::string>()}; }
+};
+
+/// counts its moves: the restored ones are expected to be built in place
+struct Tracked {
+    static inline int moves = 0;
+    int value = 0;
+    explicit Tracked(int v) : value{v} {}
+    Tracked(Tracked const&) = default;
+    Tracked(Tracked && other) noexcept : value{other.value} { ++moves; }
+    int area() const noexcept { return value; }
+    std::string name() const { return "tracked"; }
+};
+
+template <>
+struct vx::serializer<Tracked> {
+    static void write(vx::binary_writer & out, Tracked const& t) { out.write(t.value); }
+    static Tracked read(vx::binary_reader & in) { return Tracked{in.read<int>()}; }
+};
+
+/// not registered
+struct Circle {
+    int r = 1;
+    int area() const noexcept { return 3 * r * r; }
+    std::string name() const { return "circle"; }
+};
+
+/// counts what it gets from upstream
+struct counting_resource : std::pmr::memory_resource {
+    std::size_t allocated = 0, deallocated = 0;
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocated;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        ++deallocated;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+};
+
+int main() {
+    vx::type_registry<Shape> registry;
+    registry.add<Square>(1).add<Rect>(2).add<Label>(3);
+    assert(( registry.size() == 3 && registry.contains(2) && not registry.contains(4) ));
+
+    /// Registration errors
+    {
+        vx::type_registry<Shape> other;
+        other.add<Square>(1);
+        bool thrown = false;
+        try { other.add<Rect>(1); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+        thrown = false;
+        try { other.add<Square>(2); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+        thrown = false;
+        try { other.add<Rect>(vx::type_registry<Shape>::empty_id); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown && other.size() == 1 ));
+    }
+
+    /// Type ids
+    {
+        vx::some<Shape> square {Square{2}};
+        vx::fsome<Shape> label {Label{"abc"}};
+        vx::some<Shape> empty;
+        assert(( registry.id_of(square) == 1 && registry.id_of(label) == 3 ));
+        assert(( registry.id_of(empty) == vx::type_registry<Shape>::empty_id ));
+    }
+
+    /// Single objects, some and fsome
+    {
+        std::stringstream stream;
+        vx::binary_writer out {stream};
+        registry.write(out, vx::some<Shape>{Square{3}});
+        registry.write(out, vx::fsome<Shape>{Label{"hello"}});
+        registry.write(out, vx::some<Shape>{});
+
+        vx::binary_reader in {stream};
+        auto square = registry.read<vx::some<Shape>>(in);
+        auto label = registry.read<vx::fsome<Shape>>(in);
+        auto empty = registry.read<vx::some<Shape>>(in);
+        assert(( square.try_get<Square>()->side == 3 && square->area() == 9 ));
+        assert(( label.try_get<Label>()->text == "hello" && label->name() == "label:hello" ));
+        assert(( registry.id_of(empty) == vx::type_registry<Shape>::empty_id ));
+    }
+
+    /// Written from some<>, read into fsome<> and back: the format doesn't depend on the holder
+    {
+        using small_fsome = vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>;
+        std::vector<vx::some<Shape>> shapes;
+        for (int i = 0; i < 50; ++i) {
+            if (i % 3 == 0) { shapes.emplace_back(Square{i}); }
+            else if (i % 3 == 1) { shapes.emplace_back(Rect{std::int16_t(i), 2}); }
+            else { shapes.emplace_back(Label{std::string(i, 'x')}); }
+        }
+        shapes.emplace_back(); // an empty one in the middle
+
+        std::stringstream stream;
+        vx::binary_writer out {stream};
+        registry.write(out, shapes);
+        registry.write(out, shapes);
+
+        vx::binary_reader in {stream};
+        std::vector<small_fsome> restored;
+        registry.read(in, restored);
+        assert(( restored.size() == shapes.size() ));
+        for (std::size_t i = 0; i + 1 < shapes.size(); ++i) {
+            assert(( restored[i]->area() == shapes[i]->area() && restored[i]->name() == shapes[i]->name() ));
+        }
+        assert(( restored.back().vptr() == nullptr ));
+        // the small ones are in the SBO
+        assert(( restored[0].data() == restored[0].get_sbo_buffer() ));
+        assert(( restored[2].data() != restored[2].get_sbo_buffer() ));
+
+        std::vector<vx::some<Shape>> again {Square{100}};
+        registry.read(in, again); // appends
+        assert(( again.size() == shapes.size() + 1 && again[0]->area() == 10000 ));
+        assert(( again[1].try_get<Square>()->side == 0 && again[3].try_get<Label>()->text == "xx" ));
+
+        std::stringstream copy;
+        vx::binary_writer copy_out {copy};
+        registry.write(copy_out, restored);
+        assert(( copy.str() == stream.str().substr(0, copy.str().size()) )); // same bytes
+    }
+
+    /// Restored into an arena
+    {
+        using pmr_some = vx::some<Shape, vx::cfg::some{.sbo{8}, .pmr = true}>;
+        std::stringstream stream;
+        vx::binary_writer out {stream};
+        std::vector<vx::some<Shape>> shapes;
+        for (int i = 0; i < 100; ++i) { shapes.emplace_back(Label{std::to_string(i)}); }
+        registry.write(out, shapes);
+
+        counting_resource resource;
+        {
+            vx::arena scope {&resource};
+            vx::binary_reader in {stream};
+            std::vector<pmr_some> restored;
+            registry.read(in, restored);
+            assert(( restored.size() == 100 && restored[42]->name() == "label:42" ));
+            assert(( restored[0].get_allocator().resource() == &scope ));
+            assert(( resource.allocated < 100 )); // bump-allocated in big chunks
+        }
+        assert(( resource.allocated == resource.deallocated ));
+    }
+
+    /// Relocatable some<>: the restored trivially copyable payloads are let into the SBO
+    {
+        using relocatable = vx::some<Shape, vx::cfg::some{.sbo{32}, .relocatable = true}>;
+        std::stringstream stream;
+        vx::binary_writer out {stream};
+        registry.write(out, std::vector<vx::some<Shape>>{Square{5}, Rect{2, 3}});
+        vx::binary_reader in {stream};
+        std::vector<relocatable> restored;
+        registry.read(in, restored);
+        assert(( restored[0]->area() == 25 && restored[1]->area() == 6 ));
+    }
+
+    /// Read right into the placement: no moves, in the SBO or on the heap
+    {
+        vx::type_registry<Shape> tracking;
+        tracking.add<Tracked>(1);
+        std::stringstream stream;
+        vx::binary_writer out {stream};
+        for (int i = 0; i < 4; ++i) { tracking.write(out, vx::some<Shape>{std::in_place_type<Tracked>, i}); }
+        vx::binary_reader in {stream};
+        Tracked::moves = 0;
+        auto a = tracking.read<vx::some<Shape>>(in);
+        auto b = tracking.read<vx::some<Shape, vx::cfg::some{.sbo{0}}>>(in);
+        auto c = tracking.read<vx::fsome<Shape>>(in);
+        auto d = tracking.read<vx::fsome<Shape, vx::cfg::fsome{.sbo{0}}>>(in);
+        assert(( Tracked::moves == 0 ));
+        assert(( a->area() == 0 && b->area() == 1 && c->area() == 2 && d->area() == 3 ));
+    }
+
+    /// Errors
+    {
+        std::stringstream stream;
+        vx::binary_writer out {stream};
+        bool thrown = false;
+        try { registry.write(out, vx::some<Shape>{Circle{}}); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+
+        std::stringstream unknown;
+        vx::binary_writer unknown_out {unknown};
+        unknown_out.write(std::uint32_t{7});
+        vx::binary_reader unknown_in {unknown};
+        thrown = false;
+        try { (void)registry.read<vx::some<Shape>>(unknown_in); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+
+        std::stringstream cut;
+        vx::binary_writer cut_out {cut};
+        registry.write(cut_out, std::vector<vx::some<Shape>>{Square{1}, Label{"abcdef"}});
+        std::stringstream truncated {cut.str().substr(0, cut.str().size() - 2)};
+        vx::binary_reader cut_in {truncated};
+        std::vector<vx::some<Shape>> partial;
+        thrown = false;
+        try { registry.read(cut_in, partial); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown && partial.size() == 1 && partial[0]->area() == 1 )); // what was read is kept
+
+        // a corrupt count or size runs into the end of the stream, not into a huge allocation
+        std::stringstream huge_count;
+        vx::binary_writer huge_count_out {huge_count};
+        huge_count_out.write(std::uint64_t{1} << 40); // below max_size(), no room for it all the same
+        huge_count_out.write(std::uint32_t{1});
+        huge_count_out.write(Square{2});
+        vx::binary_reader huge_count_in {huge_count};
+        std::vector<vx::fsome<Shape>> few;
+        thrown = false;
+        try { registry.read(huge_count_in, few); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown && few.size() == 1 && few.capacity() < 4096 ));
+
+        std::stringstream huge_size;
+        vx::binary_writer huge_size_out {huge_size};
+        huge_size_out.write(std::uint32_t{3});
+        huge_size_out.write(std::uint64_t{1} << 50);
+        huge_size_out.write_bytes("abc", 3);
+        vx::binary_reader huge_size_in {huge_size};
+        thrown = false;
+        try { (void)registry.read<vx::some<Shape>>(huge_size_in); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+
+        huge_size_out.write(std::uint32_t{3});
+        huge_size_out.write(~std::uint64_t{0}); // more than a string can hold
+        thrown = false;
+        try { (void)registry.read<vx::some<Shape>>(huge_size_in); } catch (vx::serialization_error const&) { thrown = true; }
+        assert(( thrown ));
+    }
+}
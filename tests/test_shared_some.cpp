@@ -0,0 +1,105 @@
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../shared_some.hpp"
+
+unsigned count_destroyed = 0;
+
+struct Config : vx::trait {
+    virtual std::string name() const = 0;
+    virtual int limit() const noexcept = 0;
+    virtual void bump() noexcept = 0; // not callable through a shared_some
+};
+
+template <typename T>
+struct vx::impl<Config, T> final : vx::impl_for<Config, T> {
+    using vx::impl_for<Config, T>::impl_for;
+    using vx::impl_for<Config, T>::self;
+    std::string name() const override { return self().name(); }
+    int limit() const noexcept override { return self().limit; }
+    void bump() noexcept override { ++self().limit; }
+};
+
+struct RateLimit {
+    int limit = 100;
+    std::string name() const { return "rate"; }
+    ~RateLimit() { ++count_destroyed; }
+};
+
+struct Route {
+    int limit = 0;
+    std::string target;
+    std::string name() const { return "route:" + target; }
+};
+
+template <typename T>
+concept can_bump = requires (T & t) { t->bump(); };
+
+int main() {
+    /// Sharing
+    {
+        vx::shared_some<Config> a {RateLimit{}};
+        count_destroyed = 0;
+        assert(( a->name() == "rate" && a->limit() == 100 && a.use_count() == 1 ));
+
+        auto b = a;
+        assert(( a.use_count() == 2 && &*a == &*b ));
+        assert(( b.try_get<RateLimit>() != nullptr && b.try_get<Route>() == nullptr ));
+
+        b = vx::shared_some<Config>{Route{7, "home"}};
+        assert(( b->name() == "route:home" && a.use_count() == 1 ));
+
+        a.reset();
+        assert(( not a && count_destroyed == 1 ));
+
+        static_assert( not can_bump<vx::shared_some<Config>> ); // const-only
+        static_assert( can_bump<vx::some<Config>> );
+    }
+
+    /// From an rvalue some
+    {
+        vx::some<Config> small {Route{1, "a"}};
+        vx::some<Config> big {Route{2, std::string(100, 'b')}};
+        vx::shared_some<Config> s1 {std::move(small)};
+        vx::shared_some<Config> s2 {std::move(big)};
+        assert(( s1->name() == "route:a" && s2->limit() == 2 && s2->name().size() == 106 ));
+        assert(( s1.use_count() == 1 && s2.try_get<Route>()->target.size() == 100 ));
+
+        vx::some<Config> empty;
+        vx::shared_some<Config> s3 {std::move(empty)};
+        assert(( not s3 ));
+    }
+
+    /// Weak references
+    {
+        count_destroyed = 0;
+        vx::weak_some<Config> weak;
+        {
+            vx::shared_some<Config> shared {RateLimit{}};
+            count_destroyed = 0;
+            weak = shared;
+            assert(( not weak.expired() && weak.lock()->limit() == 100 ));
+            auto locked = weak.lock();
+            assert(( shared.use_count() == 2 ));
+        }
+        assert(( weak.expired() && not weak.lock() && count_destroyed == 1 ));
+    }
+
+    /// Across threads
+    {
+        vx::shared_some<Config> shared {Route{3, "x"}};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([shared] {
+                for (int i = 0; i < 1000; ++i) {
+                    auto copy = shared;
+                    vx::weak_some<Config> weak = copy;
+                    assert(( weak.lock()->limit() == 3 ));
+                }
+            });
+        }
+        for (auto & t : threads) { t.join(); }
+        assert(( shared.use_count() == 1 ));
+    }
+}
@@ -0,0 +1,170 @@
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../soa_vector.hpp"
+
+struct Shape : vx::trait {
+    virtual int info() const noexcept = 0;
+    virtual void bump() noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> final : vx::impl_for<Shape, T> {
+    using vx::impl_for<Shape, T>::impl_for;
+    using vx::impl_for<Shape, T>::self;
+    int info() const noexcept override { return self().info(); }
+    void bump() noexcept override { self().bump(); }
+};
+
+struct Square {
+    int side = 0;
+    int info() const noexcept { return side; }
+    void bump() noexcept { ++side; }
+};
+
+struct Circle {
+    int radius = 0;
+    int info() const noexcept { return radius; }
+    void bump() noexcept { --radius; }
+};
+
+/// not trivially relocatable: never in a slot
+struct Label {
+    std::string text;
+    int info() const noexcept { return static_cast<int>(text.size()); }
+    void bump() noexcept { text += '!'; }
+};
+
+/// too big for the slots
+struct Polygon {
+    int sides = 0;
+    int vertices[16] {};
+    int info() const noexcept { return sides; }
+    void bump() noexcept { ++sides; }
+};
+
+int alive = 0;
+
+struct Counted {
+    int value = 0;
+    explicit Counted(int v) : value{v} { ++alive; }
+    Counted(Counted const& other) : value{other.value} { ++alive; }
+    ~Counted() { --alive; }
+    int info() const noexcept { return value; }
+    void bump() noexcept { ++value; }
+};
+
+template <>
+struct vx::is_trivially_relocatable<Counted> : std::true_type {};
+
+using fsome_sbo = vx::fsome<Shape, vx::cfg::fsome{.sbo{16}}>;
+using soa_sbo = vx::soa_vector<Shape, vx::cfg::fsome{.sbo{16}}>;
+
+int main() {
+    /// The handles are what the fsomes keep inline
+    {
+        soa_sbo shapes;
+        shapes.push_back(Square{2});
+        shapes.emplace_back<Circle>(3);
+        shapes.push_back(Label{"abc"});
+        shapes.push_back(Polygon{5});
+        assert(( shapes.size() == 4 && shapes[0]->info() == 2 && shapes[1]->info() == 3 ));
+        assert(( shapes[2]->info() == 3 && shapes[3]->info() == 5 ));
+
+        fsome_sbo square = Square{1};
+        vx::fsome<Shape> circle = Circle{1};
+        assert(( shapes.vptrs()[0] == square.vptr() && shapes.vptrs()[1] == circle.vptr() ));
+        assert(( shapes[0].vptr() == soa_sbo::vptr_of<Square>() ));
+        assert(( shapes[0].try_get<Square>()->side == 2 && shapes[0].try_get<Circle>() == nullptr ));
+
+        shapes[1]->bump();
+        for (auto shape : shapes) { shape->bump(); }
+        assert(( shapes[1]->info() == 1 && shapes[2]->info() == 4 && shapes.at(3)->info() == 6 ));
+
+        soa_sbo const& view = shapes;
+        static_assert(std::is_same_v<decltype(view[0].operator->()), Shape const*>);
+        int total = 0;
+        for (auto shape : view) { total += shape->info(); }
+        assert(( total == 3 + 1 + 4 + 6 ));
+
+        bool thrown = false;
+        try { (void)shapes.at(4); } catch (std::out_of_range const&) { thrown = true; }
+        assert(( thrown ));
+    }
+
+    /// In the slots: the small and trivially relocatable, kept there across the growth
+    {
+        soa_sbo shapes;
+        for (int i = 0; i < 100; ++i) {
+            if (i % 2) { shapes.push_back(Square{i}); } else { shapes.push_back(Label{std::string(std::size_t(i % 7), '-')}); }
+        }
+        auto const* first_square = shapes[1].data();
+        shapes.reserve(1000); // the slots move
+        assert(( shapes[1].data() != first_square ));
+        for (int i = 0; i < 100; ++i) {
+            assert(( shapes[std::size_t(i)]->info() == (i % 2 ? i : i % 7) ));
+        }
+
+        vx::soa_vector<Shape> no_slots;
+        no_slots.push_back(Square{4});
+        assert(( no_slots[0]->info() == 4 ));
+    }
+
+    /// The vptr-only scans
+    {
+        soa_sbo shapes;
+        for (int i = 0; i < 30; ++i) {
+            if (i % 3 == 0) { shapes.push_back(Square{i}); } else { shapes.push_back(Circle{i}); }
+        }
+        assert(( shapes.count<Square>() == 10 && shapes.count<Circle>() == 20 && shapes.count<Label>() == 0 ));
+        assert(( shapes.find<Circle>() == 1 && shapes.find<Square>(1) == 3 && shapes.find<Label>() == shapes.size() ));
+        assert(( shapes.find<Square>(100) == shapes.size() ));
+
+        int squares = 0;
+        shapes.for_each<Square>([&](Square & square) { squares += square.side; ++square.side; });
+        assert(( squares == 135 ));
+        std::as_const(shapes).for_each<Square>([&](Square const& square) { squares -= square.side; });
+        assert(( squares == -10 ));
+    }
+
+    /// Taking over the fsomes
+    {
+        soa_sbo shapes;
+        fsome_sbo in_sbo = Square{7};
+        fsome_sbo on_heap = Label{"label"};
+        auto const* heap_object = on_heap.data();
+        vx::fsome<Shape> plain = Circle{9};
+        fsome_sbo empty;
+
+        shapes.push_back(std::move(in_sbo));
+        shapes.push_back(std::move(on_heap));
+        shapes.push_back(std::move(plain));
+        shapes.push_back(std::move(empty));
+        assert(( in_sbo.vptr() == nullptr && on_heap.vptr() == nullptr && plain.vptr() == nullptr ));
+        assert(( shapes[0]->info() == 7 && shapes[1]->info() == 5 && shapes[2]->info() == 9 ));
+        assert(( shapes[1].data() == heap_object )); // handed over as is
+        assert(( shapes.vptrs()[3] == nullptr && shapes.count<Square>() == 1 ));
+    }
+
+    /// Destruction: the slots in place, the heap through the delete
+    {
+        {
+            soa_sbo shapes;
+            for (int i = 0; i < 50; ++i) { shapes.emplace_back<Counted>(i); }
+            shapes.push_back(fsome_sbo{Counted{50}});
+            vx::soa_vector<Shape> on_heap;
+            on_heap.emplace_back<Counted>(0);
+            assert(( alive == 52 ));
+            shapes.pop_back();
+            assert(( alive == 51 && shapes.size() == 50 ));
+
+            soa_sbo moved {std::move(shapes)};
+            assert(( moved.size() == 50 && shapes.empty() && moved[49]->info() == 49 ));
+            shapes = std::move(moved);
+            assert(( alive == 51 && shapes[10]->info() == 10 ));
+        }
+        assert(( alive == 0 ));
+    }
+}
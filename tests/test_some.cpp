@@ -1,7 +1,11 @@
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
 #include "../some.hpp"
 
 unsigned count_created = 0;
@@ -175,6 +179,91 @@ void read_object(vx::some<TestInterface> const& c) {
 }
 
 
+struct Small {
+    int x = 0;
+    int number() const noexcept { return x; }
+    void test() const noexcept {}
+    int mut() { return x++; }
+};
+
+/// Counts its destructions, so that we know the non-trivial payloads are still cleaned up in an arena
+struct Tracked {
+    static inline int destroyed = 0;
+    int x = 0;
+    Tracked(int n) : x{n} {}
+    Tracked(Tracked const&) = default;
+    ~Tracked() { ++destroyed; }
+    int number() const noexcept { return x; }
+    void test() const noexcept {}
+    int mut() { return x++; }
+};
+
+/// Not trivially copyable, but declared trivially relocatable
+struct Handle {
+    static inline int destroyed = 0;
+    int * value = nullptr;
+    Handle(int n) : value{new int{n}} {}
+    Handle(Handle const& other) : value{new int{*other.value}} {}
+    Handle(Handle && other) noexcept : value{std::exchange(other.value, nullptr)} {}
+    ~Handle() { ++destroyed; delete value; }
+    int number() const noexcept { return *value; }
+    void test() const noexcept {}
+    int mut() { return (*value)++; }
+};
+
+template <>
+struct vx::is_trivially_relocatable<Handle> : std::true_type {};
+
+/// Counts its move constructions, the ones a trivial relocation skips; one type per N
+template <int N>
+struct Relocated {
+    static inline int moves = 0;
+    int x = N;
+    Relocated() = default;
+    Relocated(Relocated const&) = default;
+    Relocated(Relocated && other) noexcept : x{other.x} { ++moves; }
+    int number() const noexcept { return x; }
+    void test() const noexcept {}
+    int mut() { return x++; }
+};
+
+template <int N>
+struct vx::is_trivially_relocatable<Relocated<N>> : std::true_type {};
+
+/// moves some<> and fsome<> objects (and some<> copies) of the Relocated<Ns>... out of their SBO:
+/// all of them with a memcpy, however many types
+template <int... Ns>
+bool relocated_without_moves(std::integer_sequence<int, Ns...>) {
+    auto relocated = []<int N>(Relocated<N> *) {
+        vx::some<TestInterface> object {std::in_place_type<Relocated<N>>};
+        vx::fsome<TestInterface, vx::cfg::fsome{.sbo{16}}> fobject {std::in_place_type<Relocated<N>>};
+        vx::some<TestInterface> moved {std::move(object)};
+        vx::fsome<TestInterface, vx::cfg::fsome{.sbo{16}}> fmoved {std::move(fobject)};
+        vx::some<TestInterface> copy {moved};
+        vx::some<TestInterface> moved_copy {std::move(copy)};
+        return Relocated<N>::moves == 0 && moved_copy->number() == N && fmoved->number() == N;
+    };
+    return (relocated(static_cast<Relocated<Ns>*>(nullptr)) && ...);
+}
+
+/// Counts the allocations made through it, the memory itself comes from the new_delete_resource
+struct counting_resource : std::pmr::memory_resource {
+    unsigned allocated = 0;
+    unsigned deallocated = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocated;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocated;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+};
+
+
 /// Shape example 
 struct Triangle {
     Triangle() { std::cerr << "Triangle\n"; }
@@ -263,6 +352,16 @@ int main() {
         static_assert(std::is_constructible_v< vx::poly_view<TestInterface>, Object& >);
         static_assert(not std::is_constructible_v< vx::poly_view<TestInterface>, const Object& >);
 
+        // copying a view views the same object, assigning one rebinds it
+        auto sr2_copy = sr2;
+        vx::some<TestInterface&> sr2_other = v2;
+        assert(( sr2_copy->number() == v.number() ));
+        sr2_copy->mut();
+        assert(( v.number() == 9 ));
+        sr2_copy = sr2_other;
+        assert(( sr2_copy->number() == v2.number() && sr2->number() == v.number() ));
+        v.x = 8;
+
         const vx::some_ptr<TestInterface> csp = &v;
         assert(( sp->number() == v2.number() ));
         assert(( sp->number() != sr2->number() ));
@@ -552,5 +651,378 @@ int main() {
         anything = std::string{"hi"};
         std::cout << vx::some_cast<std::string const&>(anything);
     }
+
+    /// Copying the mixed traits:
+    {
+        FooBar fb{};
+        vx::some<vx::mix<Fooable,Barable>> mixed = fb;
+        vx::some<vx::mix<Fooable,Barable>> copy = mixed;
+        vx::some<vx::mix<Fooable,Barable>, vx::cfg::some{.sbo{0}}> heap_copy = copy;
+        heap_copy->foo();
+        heap_copy.as<Barable>()->bar();
+        assert( copy.try_get<FooBar>() != nullptr );
+        assert( heap_copy.try_get<FooBar>() != nullptr );
+    }
+
+    /// Memory resources:
+    {
+        using pmr_some = vx::some<TestInterface, vx::cfg::some{.pmr=true}>;
+        using pmr_fsome = vx::fsome<TestInterface, vx::cfg::fsome{.pmr=true}>;
+
+        static_assert(std::uses_allocator_v<pmr_some, std::pmr::polymorphic_allocator<pmr_some>>);
+        static_assert(std::uses_allocator_v<pmr_fsome, std::pmr::polymorphic_allocator<pmr_fsome>>);
+        static_assert(not std::uses_allocator_v<vx::some<TestInterface>, std::pmr::polymorphic_allocator<>>);
+        static_assert(sizeof(vx::fsome<TestInterface, vx::cfg::fsome{.pmr=true}>) == 3*sizeof(void*));
+
+        counting_resource resource{};
+        {
+            pmr_some s {std::allocator_arg, &resource, Object{42}}; // too big for the SBO
+            assert(( resource.allocated == 1 ));
+            assert(( s.get_allocator().resource() == &resource ));
+            assert(( s->number() == 42 ));
+
+            pmr_some copy {std::allocator_arg, &resource, s};
+            assert(( resource.allocated == 2 ));
+            pmr_some moved {std::move(copy)}; // hands the object over
+            assert(( resource.allocated == 2 ));
+            assert(( moved->number() == 42 ));
+
+            pmr_some on_default_resource {moved}; // like pmr containers, copies don't propagate the resource
+            assert(( resource.allocated == 2 ));
+            on_default_resource = std::move(s); // different resources => the object is moved, not handed over
+            assert(( on_default_resource.get_allocator().resource() == std::pmr::get_default_resource() ));
+            assert(( resource.allocated == 2 ));
+
+            pmr_some small {std::allocator_arg, &resource, Small{7}}; // fits into the SBO
+            assert(( resource.allocated == 2 ));
+
+            pmr_fsome f {std::allocator_arg, &resource, Object{7}};
+            assert(( resource.allocated == 3 ));
+            pmr_fsome f_copy {std::allocator_arg, &resource, f};
+            assert(( resource.allocated == 4 ));
+            pmr_fsome f_moved {std::move(f_copy)};
+            assert(( resource.allocated == 4 ));
+            assert(( f_moved->number() == 7 ));
+            f_moved = Object{8};
+            assert(( resource.allocated == 5 ));
+            assert(( f_moved->number() == 8 ));
+        }
+        assert(( resource.allocated == resource.deallocated ));
+
+        {
+            std::pmr::vector<pmr_some> shapes (&resource);
+            std::pmr::vector<pmr_fsome> fshapes (&resource);
+            for (int i = 0; i < 10; ++i) {
+                shapes.emplace_back(Object{i});
+                fshapes.emplace_back(Object{i});
+            }
+            for (auto & s : shapes) { assert(( s.get_allocator().resource() == &resource )); }
+            for (auto & f : fshapes) { assert(( f.get_allocator().resource() == &resource )); }
+            assert(( shapes[9]->number() == 9 && fshapes[9]->number() == 9 ));
+            assert(( resource.allocated > 20 )); // 20 objects + vector buffers
+        }
+        assert(( resource.allocated == resource.deallocated ));
+    }
+
+    /// try_get by the type token:
+    {
+        vx::some<TestInterface> s {Small{1}};
+        vx::some<TestInterface> const cs {Object{2}};
+        vx::fsome<TestInterface> f {Small{3}};
+        Small small {4};
+        vx::some<TestInterface&> view {small};
+        vx::some<TestInterface, vx::cfg::some{.check_empty=false}> empty {};
+
+        for (int pass = 0; pass < 2; ++pass) { // the second pass goes by the remembered vptrs
+            assert(( s.try_get<Small>() != nullptr && s.try_get<Small>()->x == 1 ));
+            assert(( s.try_get<Object>() == nullptr ));
+            assert(( cs.try_get<Object>()->x == 2 && cs.try_get<const Object>()->x == 2 ));
+            assert(( cs.try_get<Small>() == nullptr ));
+            assert(( f.try_get<Small>()->x == 3 && f.try_get<Object>() == nullptr ));
+            assert(( view.try_get<Small>() == &small && view.try_get<Object>() == nullptr ));
+            assert(( empty.try_get<Small>() == nullptr ));
+            assert(( vx::some_cast<Small&>(s).x == 1 ));
+        }
+
+        /// the same T held by different containers has different impls
+        assert(( vx::detail::impl_vptr<vx::impl<TestInterface, Small>, TestInterface>.load() 
+                 != vx::detail::impl_vptr<vx::impl<TestInterface, Small*>, TestInterface>.load() ));
+
+        vx::some<vx::mix<Fooable, Barable>> mixed {FooBar{}};
+        assert(( mixed.try_get<FooBar>() != nullptr && mixed.try_get<Small>() == nullptr ));
+        assert(( mixed.try_get<FooBar>() == mixed.try_get<FooBar>() ));
+    }
+
+    /// Arena:
+    {
+        using pmr_some = vx::some<TestInterface, vx::cfg::some{.pmr=true}>;
+        using pmr_fsome = vx::fsome<TestInterface, vx::cfg::fsome{.pmr=true}>;
+
+        counting_resource resource{};
+        assert(( vx::arena::current() == nullptr ));
+        {
+            vx::arena scope {&resource};
+            assert(( vx::arena::current() == &scope ));
+
+            std::vector<pmr_some> objects;
+            std::vector<pmr_fsome> fobjects;
+            for (int i = 0; i < 100; ++i) {
+                objects.emplace_back(Object{i}); // heap-allocated, from the arena
+                fobjects.emplace_back(Object{i});
+            }
+            assert(( objects[0].get_allocator().resource() == &scope ));
+            assert(( fobjects[0].get_allocator().resource() == &scope ));
+            assert(( objects[99]->number() == 99 && fobjects[99]->number() == 99 ));
+            assert(( resource.allocated < 100 )); // bump-allocated in big chunks
+            assert(( resource.deallocated == 0 ));
+
+            objects[0] = Object{1000};
+            assert(( objects[0]->number() == 1000 ));
+
+            Tracked::destroyed = 0;
+            {
+                pmr_some tracked {Tracked{1}};
+                pmr_fsome ftracked {Tracked{2}};
+                pmr_some copy {tracked};
+                assert(( copy->number() == 1 && ftracked->number() == 2 ));
+                Tracked::destroyed = 0;
+            }
+            assert(( Tracked::destroyed == 3 )); // non-trivial payloads are still destroyed
+
+            {
+                vx::arena nested {&resource};
+                assert(( vx::arena::current() == &nested ));
+                pmr_some inner {Object{1}};
+                assert(( inner.get_allocator().resource() == &nested ));
+                objects.emplace_back(std::allocator_arg, &scope, std::move(inner)); // outlives the nested arena
+                assert(( objects.back().get_allocator().resource() == &scope ));
+
+                // the conversions take the resource along, so the heap-resident object changes hands as is
+                pmr_some on_scope {std::allocator_arg, &scope, Object{2}};
+                auto const* object = on_scope.try_get<Object>();
+                pmr_fsome f_on_scope = std::move(on_scope);
+                assert(( f_on_scope.data() == object && f_on_scope.get_allocator().resource() == &scope ));
+                pmr_some back = std::move(f_on_scope);
+                assert(( back.try_get<Object>() == object && back.get_allocator().resource() == &scope ));
+            }
+            assert(( vx::arena::current() == &scope ));
+            assert(( objects.back()->number() == 1 ));
+        }
+        assert(( vx::arena::current() == nullptr ));
+        assert(( resource.allocated == resource.deallocated ));
+    }
     
+    /// Trivial relocation:
+    {
+        // trivially copyable payloads in the SBO are moved with a memcpy, the moved-from object is left empty
+        vx::some<TestInterface> small {Small{7}};
+        vx::some<TestInterface> moved {std::move(small)};
+        assert(( moved->number() == 7 && moved.try_get<Small>() != nullptr ));
+        small = Small{8};
+        moved = std::move(small);
+        assert(( moved->number() == 8 ));
+
+        std::vector<vx::some<TestInterface>> objects;
+        for (int i = 0; i < 100; ++i) { objects.emplace_back(Small{i}); }
+        objects.emplace_back(Tracked{100}); // non-trivial ones still go through the virtual move
+        std::sort(objects.begin(), objects.end(), [](auto const& a, auto const& b) { return a->number() > b->number(); });
+        for (int i = 0; i < 101; ++i) { assert(( objects[i]->number() == 100 - i )); }
+        assert(( objects[0].try_get<Tracked>() != nullptr ));
+
+        vx::fsome<TestInterface> fsmall {Small{7}};
+        vx::fsome<TestInterface> fmoved {std::move(fsmall)};
+        assert(( fmoved->number() == 7 && fmoved.try_get<Small>() != nullptr ));
+        fmoved->mut();
+        vx::fsome<TestInterface, vx::cfg::fsome{.sbo{32}}> fbigger {std::move(fmoved)};
+        assert(( fbigger->number() == 8 ));
+
+        std::vector<vx::fsome<TestInterface>> fobjects;
+        for (int i = 0; i < 100; ++i) { fobjects.emplace_back(Small{i}); }
+        Tracked::destroyed = 0;
+        fobjects.emplace_back(Tracked{100});
+        std::sort(fobjects.begin(), fobjects.end(), [](auto const& a, auto const& b) { return a->number() > b->number(); });
+        for (int i = 0; i < 101; ++i) { assert(( fobjects[i]->number() == 100 - i )); }
+        fobjects.clear();
+        assert(( Tracked::destroyed > 0 ));
+
+        // no limit on the number of types
+        assert(( relocated_without_moves(std::make_integer_sequence<int, 12>{}) ));
+    }
+    /// Relocatable layout:
+    {
+        using relocatable_some = vx::some<TestInterface, vx::cfg::some{.relocatable=true}>;
+        static_assert(( vx::is_trivially_relocatable_v<relocatable_some> ));
+        static_assert(( not vx::is_trivially_relocatable_v<vx::some<TestInterface>> ));
+        static_assert(( vx::is_trivially_relocatable_v<vx::some<TestInterface, vx::cfg::some{.sbo{0}}>> ));
+        static_assert(( vx::is_trivially_relocatable_v<vx::fsome<TestInterface>> ));
+        static_assert(( not vx::is_trivially_relocatable_v<vx::fsome<TestInterface, vx::cfg::fsome{.sbo{16}}>> ));
+        static_assert(( sizeof(relocatable_some) == sizeof(vx::some<TestInterface>) ));
+
+        alignas(relocatable_some) std::byte from[4 * sizeof(relocatable_some)];
+        alignas(relocatable_some) std::byte to[4 * sizeof(relocatable_some)];
+        auto * objects = reinterpret_cast<relocatable_some*>(from);
+        new(objects + 0) relocatable_some{Small{1}};        // SBO
+        new(objects + 1) relocatable_some{Tracked{2}};      // not trivially relocatable: heap
+        new(objects + 2) relocatable_some{Handle{3}};       // declared trivially relocatable: SBO
+        new(objects + 3) relocatable_some{vx::some<TestInterface>{Tracked{4}}}; // from the SBO of a some<> to the heap
+
+        Tracked::destroyed = 0;
+        Handle::destroyed = 0;
+        auto * relocated = reinterpret_cast<relocatable_some*>(to);
+        auto * end = vx::relocate(objects, objects + 4, relocated);
+        assert(( end == relocated + 4 ));
+        assert(( Tracked::destroyed == 0 && Handle::destroyed == 0 )); // nothing moved, nothing destroyed
+        for (int i = 0; i < 4; ++i) {
+            assert(( relocated[i]->number() == i + 1 ));
+            relocated[i]->mut();
+            assert(( relocated[i]->number() == i + 2 ));
+        }
+
+        relocatable_some copy {relocated[2]};
+        relocatable_some moved {std::move(relocated[0])};
+        assert(( copy->number() == 4 && moved->number() == 2 ));
+
+        std::destroy(relocated, relocated + 4);
+        assert(( Tracked::destroyed == 2 && Handle::destroyed == 1 ));
+
+        Handle::destroyed = 0;
+        {
+            alignas(Handle) std::byte source[sizeof(Handle)];
+            alignas(Handle) std::byte buffer[sizeof(Handle)];
+            auto * handle = new(source) Handle{5};
+            auto * p = vx::relocate(handle, reinterpret_cast<Handle*>(buffer));
+            assert(( p->number() == 5 && Handle::destroyed == 0 ));
+            std::destroy_at(new(source) Handle{6}); // the source is gone, starts a new one there
+            std::destroy_at(p);
+        }
+        assert(( Handle::destroyed == 2 ));
+
+        // the SBO admission is the object's own (compile-time) trivial relocatability, whichever way it comes in
+        auto in_sbo = [](auto const& object) {
+            auto const at = reinterpret_cast<std::uintptr_t>(object.operator->());
+            auto const self = reinterpret_cast<std::uintptr_t>(&object);
+            return at >= self && at < self + sizeof(object);
+        };
+        relocatable_some constructed {std::in_place_type<Relocated<11>>}; // the 12th type registered above
+        relocatable_some copied {constructed};
+        relocatable_some from_some {vx::some<TestInterface>{Relocated<12>{}}};
+        relocatable_some from_fsome {vx::fsome<TestInterface, vx::cfg::fsome{.sbo{16}}>{Relocated<13>{}}};
+        relocatable_some not_relocatable {vx::some<TestInterface>{Tracked{1}}};
+        assert(( in_sbo(constructed) && in_sbo(copied) && in_sbo(from_some) && in_sbo(from_fsome) ));
+        assert(( not in_sbo(not_relocatable) ));
+        assert(( copied->number() == 11 && from_some->number() == 12 && from_fsome->number() == 13 ));
+    }
+
+    /// Speculative devirtualization:
+    {
+        vx::likely_counter counter;
+        std::vector<vx::fsome<TestInterface>> objects;
+        objects.emplace_back(Object{1});
+        objects.emplace_back(Handle{2});
+        objects.emplace_back(Object{3});
+        int sum = 0;
+        for (auto & o : objects) {
+            sum += vx::visit_likely<Object>(o, [](auto & x) { return x.number(); }, &counter);
+        }
+        assert(( sum == 6 && counter.hits == 2 && counter.misses == 1 ));
+
+        counter.reset();
+        vx::some<TestInterface> const s {Handle{4}};
+        assert(( (vx::likely<Object, Handle>(s, &counter) ->* [](auto const& x) { return x.number(); }) == 4 ));
+        assert(( counter.hits == 1 && counter.hit_rate() == 1.0 ));
+
+        vx::some<TestInterface> m {Object{5}};
+        vx::visit_likely<Object>(m, [](auto & x) { return x.mut(); }); // the hit is non-const for a non-const some
+        assert(( m->number() == 6 ));
+    }
+
+    /// Conversions between some, fsome and poly_view:
+    {
+        using unchecked = vx::some<TestInterface, vx::cfg::some{.check_empty = false}>;
+        unchecked small {Handle{1}};
+        unchecked big {Object{2}};
+        auto const* big_object = big.try_get<Object>();
+        vx::fsome<TestInterface, vx::cfg::fsome{.sbo{16}}> f_small = std::move(small);
+        vx::fsome<TestInterface> f_big = std::move(big);
+        assert(( f_small->number() == 1 && f_big->number() == 2 && f_big.try_get<Object>()->arr[99] == 2 ));
+        assert(( f_small.data() == f_small.get_sbo_buffer() && f_small.try_get<Handle>() != nullptr ));
+        assert(( small.try_get<Handle>() == nullptr && big.try_get<Object>() == nullptr )); // emptied
+        assert(( f_big.data() == big_object )); // the heap-resident one is handed over in its impl, not moved
+
+        vx::some<TestInterface> back_small = std::move(f_small);
+        vx::some<TestInterface, vx::cfg::some{.sbo{0}}> back_big = std::move(f_big);
+        assert(( back_small->number() == 1 && back_small.try_get<Handle>() != nullptr ));
+        assert(( back_big->number() == 2 && back_big.try_get<Object>()->x == 2 ));
+        assert(( back_big.try_get<Object>() == big_object )); // and back
+        assert(( f_small.vptr() == nullptr && f_big.vptr() == nullptr ));
+
+        vx::some<TestInterface, vx::cfg::some{.relocatable = true}> relocatable = vx::fsome<TestInterface>{Handle{3}};
+        assert(( relocatable->number() == 3 ));
+
+        // a pointer-like object: the some calls its pointee, it can't go into an fsome (the some keeps it)
+        vx::some<TestInterface> shared = std::make_shared<Object>(4);
+        vx::some<TestInterface> shared_copy = shared;
+        assert(( shared_copy->number() == 4 ));
+        bool rejected = false;
+        try { vx::fsome<TestInterface> f_shared = std::move(shared); } catch (vx::bad_some_conversion const&) { rejected = true; }
+        assert(( rejected && shared->number() == 4 ));
+
+        // the views go to the object, not to the some/fsome holding it
+        vx::poly_view<TestInterface> view_some {back_big};
+        view_some->mut();
+        assert(( back_big->number() == 3 && view_some->number() == 3 ));
+
+        vx::some<TestInterface> empty;
+        bool thrown = false;
+        try { vx::poly_view<TestInterface> nothing {empty}; } catch (vx::empty_some_access const&) { thrown = true; }
+        assert(( thrown ));
+
+        vx::fsome<TestInterface> owner {Object{7}};
+        vx::poly_view<TestInterface> view_fsome {owner};
+        vx::poly_view<TestInterface const> cview {std::as_const(owner)};
+        view_fsome->mut();
+        assert(( owner->number() == 8 && cview->number() == 8 ));
+        assert(( view_fsome.try_get<Object>() == owner.try_get<Object>() && std::as_const(cview).try_get<Object>() != nullptr ));
+        assert(( vx::some_cast<Object>(&view_fsome) == owner.try_get<Object>() ));
+
+        vx::fsome<TestInterface> empty_fsome;
+        thrown = false;
+        try { vx::poly_view<TestInterface> nothing {empty_fsome}; } catch (vx::empty_some_access const&) { thrown = true; }
+        assert(( thrown ));
+    }
+
+    /// Trait narrowing:
+    {
+        using mixed_t = vx::mix<Fooable, Barable>;
+        FooBar fb{};
+        vx::some<mixed_t, vx::cfg::some{.sbo{0}, .check_empty = false}> on_heap = fb;
+        auto const* object = &*on_heap;
+        vx::some<Fooable> foo = std::move(on_heap); // the same heap block, owned through the first trait
+        assert(( &*foo == object && not on_heap.as<Barable>() ));
+        foo->foo();
+        vx::some<Fooable> foo_copy = foo;
+        foo_copy->foo();
+
+        vx::some<mixed_t> in_sbo = fb;
+        vx::some<Fooable, vx::cfg::some{.sbo{8}}> foo_small = std::move(in_sbo); // doesn't fit: moved to the heap
+        foo_small->foo();
+
+        vx::some<FooBarable> derived = fb;
+        vx::some<Fooable> base = std::move(derived);
+        base->foo();
+
+        vx::fsome<FooBarable> f_derived = fb;
+        auto const* data = f_derived.data();
+        vx::fsome<Fooable> f_base = std::move(f_derived);
+        assert(( f_base.data() == data && f_derived.vptr() == nullptr ));
+        f_base->foo();
+
+        vx::some<Fooable> from_fsome = vx::fsome<FooBarable>{fb};
+        assert(( from_fsome.try_get<FooBar>() == nullptr )); // an impl<FooBarable, FooBar>
+        from_fsome->foo();
+
+        vx::fsome<Fooable> f_from_mixed = vx::some<mixed_t>{fb};
+        assert(( f_from_mixed.try_get<FooBar>() != nullptr ));
+        f_from_mixed->foo();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <array>
+#include <cassert>
+#include <memory>
+#include <string>
+#include "../some_of.hpp"
+
+unsigned count_alive = 0;
+
+struct Shape : vx::trait {
+    virtual int area() const noexcept = 0;
+    virtual void scale(int k) noexcept = 0;
+};
+
+template <typename T>
+struct vx::impl<Shape, T> final : vx::impl_for<Shape, T> {
+    using vx::impl_for<Shape, T>::impl_for;
+    using vx::impl_for<Shape, T>::self;
+    int area() const noexcept override { return self().area(); }
+    void scale(int k) noexcept override { self().scale(k); }
+};
+
+struct Square {
+    int side = 1;
+    int area() const noexcept { return side * side; }
+    void scale(int k) noexcept { side *= k; }
+};
+
+struct Rect {
+    int w = 1, h = 1;
+    int area() const noexcept { return w * h; }
+    void scale(int k) noexcept { w *= k; h *= k; }
+};
+
+/// bigger, non-trivial
+struct Named {
+    std::string name;
+    std::array<int, 16> data {};
+    Named(std::string n) : name{std::move(n)} { ++count_alive; }
+    Named(Named const& other) : name{other.name}, data{other.data} { ++count_alive; }
+    Named(Named && other) noexcept : name{std::move(other.name)}, data{other.data} { ++count_alive; }
+    ~Named() { --count_alive; }
+    int area() const noexcept { return static_cast<int>(name.size()); }
+    void scale(int) noexcept { name += name; }
+};
+
+using AnyShape = vx::some_of<Shape, Square, Rect, Named>;
+
+int main() {
+    /// The same impl<Trait, T> as some<>
+    {
+        AnyShape s {Square{3}};
+        assert(( s->area() == 9 && s.index() == 0 ));
+        s->scale(2);
+        assert(( (*s).area() == 36 && s.try_get<Square>()->side == 6 && s.try_get<Rect>() == nullptr ));
+
+        s = Rect{2, 5};
+        assert(( s->area() == 10 && s.index() == 1 && s.try_get<Rect>() != nullptr ));
+
+        static_assert( sizeof(AnyShape) <= sizeof(vx::impl<Shape, Named>) + alignof(vx::impl<Shape, Named>) );
+        static_assert( not std::is_constructible_v<AnyShape, int> ); // closed set
+    }
+
+    /// visit: a switch, the calls on the final impls are direct
+    {
+        AnyShape s {Rect{3, 4}};
+        int area = s.visit([](auto & shape) { shape.scale(2); return shape.area(); });
+        assert(( area == 48 ));
+        AnyShape const& cs = s;
+        assert(( cs.visit([](auto const& shape) { return shape.area(); }) == 48 && cs.try_get<Rect>()->w == 6 ));
+
+        AnyShape empty;
+        bool thrown = false;
+        try { empty.visit([](auto & shape) { return shape.area(); }); } catch (vx::empty_some_access const&) { thrown = true; }
+        assert(( thrown && empty.empty() && empty.index() == 3 ));
+    }
+
+    /// Copy, move, destruction
+    {
+        {
+            AnyShape a {Named{"abc"}};
+            AnyShape b = a;
+            assert(( count_alive == 2 && b->area() == 3 ));
+            b->scale(0);
+            assert(( a->area() == 3 && b->area() == 6 )); // independent copies
+
+            AnyShape c = std::move(b);
+            assert(( c->area() == 6 && c.try_get<Named>()->name == "abcabc" ));
+
+            a = Square{2};
+            assert(( a->area() == 4 && count_alive == 2 )); // the Named is gone from `a`
+            a = c;
+            assert(( a->area() == 6 && count_alive == 3 ));
+        }
+        assert(( count_alive == 0 ));
+    }
+
+    /// Lots of types: dispatched 8 at a time
+    {
+        struct S0 : Square {}; struct S1 : Square {}; struct S2 : Square {}; struct S3 : Square {};
+        struct S4 : Square {}; struct S5 : Square {}; struct S6 : Square {}; struct S7 : Square {};
+        using Many = vx::some_of<Shape, S0, S1, S2, S3, S4, S5, S6, S7, Rect, Named>;
+        Many m {Named{"xy"}};
+        assert(( m.index() == 9 && m.visit([](auto & s) { return s.area(); }) == 2 ));
+        m = Rect{2, 3};
+        assert(( m.index() == 8 && m.visit([](auto & s) { return s.area(); }) == 6 ));
+        m = S7{};
+        assert(( m.index() == 7 && m.visit([](auto & s) { return s.area(); }) == 1 ));
+    }
+    assert(( count_alive == 0 ));
+}